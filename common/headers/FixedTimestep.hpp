@@ -0,0 +1,58 @@
+#pragma once
+
+// Standard Headers
+#include <cstdint>
+
+namespace RA
+{
+    /**
+     * @brief Accumulator for a fixed-step simulation loop, shared by lab1 and lab2.
+     *
+     * Each frame the real elapsed time is added with Advance, which returns how many
+     * simulation steps of Step() seconds to run. The remainder stays in the accumulator,
+     * and Alpha() tells how far rendering is between the last two steps. At most
+     * MaxSteps steps are run per frame; time beyond that is dropped, so a long hitch
+     * slows the simulation down for one frame instead of stalling the loop.
+     */
+    class FixedTimestep
+    {
+    public:
+        /// @brief Constructor
+        /// @param step Simulation step in seconds
+        /// @param max_steps Maximum number of steps run to catch up in one frame
+        explicit FixedTimestep(double step = 1.0 / 120.0, int max_steps = 8);
+
+        /// @brief Add elapsed real time
+        /// @param frame_time Seconds since the previous call
+        /// @return Number of simulation steps to run this frame
+        int Advance(double frame_time);
+
+        /// @brief Simulation step in seconds.
+        double Step() const { return _step; }
+
+        /// @brief Position of the rendered frame between the previous and the current step, in [0,1).
+        float Alpha() const { return static_cast<float>(_accumulator / _step); }
+
+        /// @brief Number of steps run since construction.
+        uint64_t Ticks() const { return _ticks; }
+
+        /// @brief Simulated time in seconds (Ticks() * Step()).
+        double Time() const { return _ticks * _step; }
+
+        /// @brief Real time that was dropped because the catch-up limit was hit.
+        double DroppedTime() const { return _dropped; }
+
+        /// @brief Change the simulation step; the accumulated time is kept.
+        void SetStep(double step);
+
+        /// @brief Change the catch-up limit.
+        void SetMaxSteps(int max_steps);
+
+    private:
+        double _step;              ///< Simulation step in seconds
+        int _maxSteps;             ///< Catch-up limit per frame
+        double _accumulator = 0.0; ///< Real time not yet simulated
+        uint64_t _ticks = 0;       ///< Steps run so far
+        double _dropped = 0.0;     ///< Time lost to the catch-up limit
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+// Standard Headers
+#include <cstdint>
+#include <iostream>
+// External Headers
+#include <glad/glad.h>
+
+namespace RA
+{
+    /**
+     * @brief Thin cache of OpenGL binding and fixed-function state, shared by lab1 and lab2.
+     *
+     * Every setter compares against the last value it issued and skips the driver call when
+     * nothing would change; it returns true if the call was actually made. The cache only
+     * knows about changes made through it, so code that calls GL directly must call
+     * Invalidate() afterwards. Objects should be deleted through the Delete* helpers, so a
+     * recycled object name is never mistaken for a still-bound one.
+     *
+     * GL_ELEMENT_ARRAY_BUFFER is part of the VAO state and is always passed through.
+     */
+    class GLState
+    {
+    public:
+        /// @brief Groups of calls with their own counters.
+        enum Counter
+        {
+            PROGRAM,      ///< glUseProgram
+            VERTEX_ARRAY, ///< glBindVertexArray
+            BUFFER,       ///< glBindBuffer / glBindBufferBase
+            TEXTURE,      ///< glActiveTexture / glBindTexture
+            CAPABILITY,   ///< glEnable / glDisable
+            DEPTH,        ///< glDepthMask / glDepthFunc
+            BLEND,        ///< glBlendFunc
+            RASTER,       ///< glLineWidth / glPolygonMode
+            COUNTER_COUNT
+        };
+
+        /// @brief Debug counters of one call group.
+        struct CallStats
+        {
+            uint64_t Requested = 0; ///< Calls made through the cache
+            uint64_t Skipped = 0;   ///< Calls that were redundant and not issued
+
+            /// @brief Fraction of requested calls that were redundant.
+            double RedundantRate() const { return Requested ? static_cast<double>(Skipped) / Requested : 0.0; }
+        };
+
+        /// @brief glUseProgram
+        static bool UseProgram(GLuint program);
+
+        /// @brief glBindVertexArray
+        static bool BindVertexArray(GLuint vao);
+
+        /// @brief glBindBuffer
+        static bool BindBuffer(GLenum target, GLuint buffer);
+
+        /// @brief glBindBufferBase (also updates the generic binding of the target, as GL does)
+        static bool BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+        /// @brief glActiveTexture(GL_TEXTURE0 + unit)
+        static bool ActiveTexture(GLuint unit);
+
+        /// @brief Bind a texture to a texture unit, switching the active unit if needed
+        static bool BindTexture(GLuint unit, GLenum target, GLuint texture);
+
+        /// @brief glEnable / glDisable
+        static bool SetCapability(GLenum capability, bool enabled);
+
+        /// @brief glDepthMask
+        static bool DepthMask(bool write);
+
+        /// @brief glDepthFunc
+        static bool DepthFunc(GLenum func);
+
+        /// @brief glBlendFunc
+        static bool BlendFunc(GLenum source, GLenum destination);
+
+        /// @brief glLineWidth
+        static bool LineWidth(float width);
+
+        /// @brief glPolygonMode(GL_FRONT_AND_BACK, mode)
+        static bool PolygonMode(GLenum mode);
+
+        /// @brief Current polygon mode (GL_FILL until set otherwise)
+        static GLenum GetPolygonMode();
+
+        /// @brief glDeleteProgram, forgetting the program if it is current
+        static void DeleteProgram(GLuint program);
+
+        /// @brief glDeleteVertexArrays for one VAO, forgetting it if it is bound
+        static void DeleteVertexArray(GLuint vao);
+
+        /// @brief glDeleteBuffers for one buffer, forgetting every binding of it
+        static void DeleteBuffer(GLuint buffer);
+
+        /// @brief glDeleteTextures for one texture, forgetting every binding of it
+        static void DeleteTexture(GLuint texture);
+
+        /// @brief Forget all cached state; the next call of every setter reaches the driver.
+        static void Invalidate();
+
+        /// @brief Counters of one call group since the last ResetStats.
+        static const CallStats &GetStats(Counter counter);
+
+        /// @brief Zero all counters.
+        static void ResetStats();
+
+        /// @brief Print requested/skipped calls and the redundant-call rate of every group.
+        static void PrintStats(std::ostream &out = std::cout);
+    };
+}
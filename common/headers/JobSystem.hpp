@@ -0,0 +1,256 @@
+#pragma once
+
+// Standard Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace RA
+{
+    /**
+     * @brief Work-stealing pool of worker threads running small jobs, shared by lab1 and lab2.
+     *
+     * Every worker owns a queue: it takes its own newest job first (cache-warm) and, when
+     * the queue is empty, steals the oldest job of another queue. Threads outside the pool
+     * share one extra queue. ParallelFor spreads its batches over the queues so each worker
+     * starts with local work, and idle ones balance the rest by stealing.
+     *
+     * Submit returns a handle that can be waited on; a waiting thread runs jobs itself
+     * instead of sleeping, so waiting from inside a job cannot deadlock the pool. Jobs must
+     * not touch the GL context, which belongs to the main thread.
+     *
+     * Once the queues and the counter pool have grown to the peak load, submitting and waiting
+     * do not allocate: jobs are stored inline in the queues' ring buffers and completion
+     * counters are reused.
+     */
+    class JobSystem
+    {
+        struct Counter;
+
+    public:
+        /// @brief Move-only void() callable stored inline, so queueing a job does not allocate.
+        class Job
+        {
+        public:
+            /// @brief Largest capture a job can hold.
+            static constexpr size_t CAPACITY = 64;
+
+            Job() = default;
+
+            template <typename Function, typename = std::enable_if_t<!std::is_same<std::decay_t<Function>, Job>::value>>
+            Job(Function &&function)
+            {
+                using Stored = std::decay_t<Function>;
+                static_assert(sizeof(Stored) <= CAPACITY && alignof(Stored) <= alignof(std::max_align_t),
+                              "The job captures more than Job::CAPACITY bytes");
+
+                new (_storage) Stored(std::forward<Function>(function));
+                _operations = _OperationsOf<Stored>();
+            }
+
+            Job(Job &&other) noexcept { _MoveFrom(other); }
+
+            Job &operator=(Job &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    _Reset();
+                    _MoveFrom(other);
+                }
+                return *this;
+            }
+
+            ~Job() { _Reset(); }
+
+            void operator()() { _operations->Invoke(_storage); }
+
+            explicit operator bool() const { return _operations != nullptr; }
+
+        private:
+            /// @brief Type-erased operations of the stored callable
+            struct Operations
+            {
+                void (*Invoke)(void *storage);
+                void (*Move)(void *from, void *to); ///< Move-construct into to and destroy from
+                void (*Destroy)(void *storage);
+            };
+
+            template <typename Stored>
+            static const Operations *_OperationsOf()
+            {
+                static const Operations operations = {
+                    [](void *storage)
+                    { (*static_cast<Stored *>(storage))(); },
+                    [](void *from, void *to)
+                    {
+                        new (to) Stored(std::move(*static_cast<Stored *>(from)));
+                        static_cast<Stored *>(from)->~Stored();
+                    },
+                    [](void *storage)
+                    { static_cast<Stored *>(storage)->~Stored(); }};
+                return &operations;
+            }
+
+            void _MoveFrom(Job &other)
+            {
+                if (other._operations)
+                    other._operations->Move(other._storage, _storage);
+                _operations = other._operations;
+                other._operations = nullptr;
+            }
+
+            void _Reset()
+            {
+                if (_operations)
+                    _operations->Destroy(_storage);
+                _operations = nullptr;
+            }
+
+            alignas(std::max_align_t) unsigned char _storage[CAPACITY];
+            const Operations *_operations = nullptr;
+        };
+
+        /// @brief Completion counter of one or more submitted jobs; counters are pooled, not allocated per job.
+        class Handle
+        {
+        public:
+            Handle() = default;
+            Handle(const Handle &other);
+            Handle(Handle &&other) noexcept;
+            Handle &operator=(Handle other) noexcept;
+            ~Handle();
+
+            /// @brief Are all jobs of this handle finished.
+            bool IsDone() const;
+
+        private:
+            friend class JobSystem;
+
+            /// @brief Takes a reference to the counter
+            explicit Handle(Counter *counter);
+
+            Counter *_counter = nullptr;
+        };
+
+        /// @brief Constructor
+        /// @param workers Number of worker threads; 0 uses one less than the hardware threads
+        explicit JobSystem(unsigned workers = 0);
+
+        /// @brief Destructor – finishes the queued jobs and joins the workers.
+        ~JobSystem();
+
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        /// @brief Queue a job
+        /// @return Handle to wait on
+        Handle Submit(Job job);
+
+        /// @brief Block until the jobs of the handle are finished, running other jobs meanwhile.
+        void Wait(const Handle &handle);
+
+        /// @brief Run fn(begin, end) over [0, count) in batches of at most batch items and wait for all of them.
+        /// The calling thread takes part, so this also works with zero workers.
+        template <typename Function>
+        void ParallelFor(size_t count, size_t batch, const Function &fn)
+        {
+            // fn outlives the batches, so only a pointer to it is queued
+            _ParallelFor(count, batch, [](const void *function, size_t begin, size_t end)
+                         { (*static_cast<const Function *>(function))(begin, end); },
+                         &fn);
+        }
+
+        /// @brief Number of worker threads (the calling thread is not counted).
+        unsigned WorkerCount() const { return static_cast<unsigned>(_workers.size()); }
+
+        /// @brief Number of jobs taken from another thread's queue since construction.
+        uint64_t StealCount() const { return _steals.load(std::memory_order_relaxed); }
+
+    private:
+        /// @brief Completion counter shared by handles and tasks; back in the pool when the last reference is gone.
+        struct Counter
+        {
+            std::atomic<int> Pending{0};
+            std::atomic<int> References{0};
+        };
+
+        /// @brief Counters of all job systems; global, since a handle can outlive the system that made it.
+        struct CounterPool
+        {
+            std::mutex Mutex;
+            std::vector<std::unique_ptr<Counter>> Counters; ///< Every counter ever made
+            std::vector<Counter *> Free;                    ///< Counters without references
+        };
+
+        struct Task
+        {
+            Job Function;
+            Counter *Pending = nullptr; ///< Holds a reference until the job has run
+        };
+
+        /// @brief Job queue of one thread; the owner pops the back, thieves the front.
+        /// A ring buffer, so a queue that has grown to the peak load no longer allocates.
+        struct Queue
+        {
+            std::mutex Mutex;
+            std::vector<Task> Tasks; ///< Ring storage, its size is the capacity
+            size_t Head = 0;         ///< Slot of the front task
+            size_t Count = 0;        ///< Queued tasks
+
+            void PushBack(Task task);
+            void PopBack(Task &task);
+            void PopFront(Task &task);
+        };
+
+        /// @brief Batch callback of ParallelFor: calls the function at the first pointer with (begin, end)
+        using BatchFunction = void (*)(const void *function, size_t begin, size_t end);
+
+        void _ParallelFor(size_t count, size_t batch, BatchFunction call, const void *function);
+
+        static CounterPool &_Pool();
+
+        /// @brief Take a counter from the pool with the given number of pending jobs (and no references)
+        static Counter *_AcquireCounter(int pending);
+
+        /// @brief Add a reference to a counter
+        static void _Retain(Counter *counter);
+
+        /// @brief Drop a reference; the last one returns the counter to the pool
+        static void _Release(Counter *counter);
+
+        /// @brief Block until the counter reaches zero, running other jobs meanwhile
+        void _Wait(const Counter *counter);
+
+        /// @brief Worker thread body
+        void _WorkerLoop(size_t queue);
+
+        /// @brief Queue of the calling thread (0 for threads outside the pool)
+        size_t _CurrentQueue() const;
+
+        /// @brief Add a task to a queue and wake a sleeping worker
+        void _Push(size_t queue, Task task);
+
+        /// @brief Take a task from the own queue, or steal one from another queue
+        bool _Take(size_t queue, Task &task);
+
+        /// @brief Run one job if there is any
+        /// @return If a job was run or not
+        bool _RunOne(size_t queue);
+
+        std::vector<std::thread> _workers;           ///< Worker threads
+        std::vector<std::unique_ptr<Queue>> _queues; ///< Queue 0 is shared by outside threads, queue i + 1 belongs to worker i
+        std::atomic<int> _queued{0};                 ///< Tasks in all queues, lets idle workers sleep
+        std::atomic<uint64_t> _steals{0};            ///< Tasks taken from a foreign queue
+        std::mutex _sleepMutex;                      ///< Guards sleeping on _wake
+        std::condition_variable _wake;               ///< Signalled when a task is queued or on shutdown
+        bool _stopping = false;                      ///< Set by the destructor
+    };
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+// Standard Headers
+#include <chrono>
+#include <cstdint>
+#include <string>
+// External Headers
+#include <glad/glad.h>
+
+namespace RA
+{
+    /**
+     * @brief CPU and GPU frame profiler with Chrome trace export, shared by lab1 and lab2.
+     *
+     * CPU time is measured by RAII scopes (ProfileScope). GPU time is measured by pairs of
+     * GL_TIMESTAMP queries around a pass (GpuProfileScope). Queries are double-buffered per
+     * frame and read back only once their results are available, so the profiler never
+     * stalls the pipeline; results that are still not ready two frames later are dropped.
+     *
+     * The last HISTORY frames are kept in a ring buffer and can be written as a Chrome trace
+     * (chrome://tracing or https://ui.perfetto.dev). The profiler is off until Enable is called,
+     * and then costs one mutex lock per CPU scope and two queries per GPU scope.
+     */
+    class Profiler
+    {
+    public:
+        /// @brief Number of frames kept for export.
+        static constexpr int HISTORY = 240;
+
+        /// @brief Start recording. Needs a current GL context for the GPU scopes.
+        static void Enable();
+
+        /// @brief Is the profiler recording.
+        static bool IsEnabled();
+
+        /// @brief Mark the start of a frame; also collects the GPU results of older frames.
+        static void BeginFrame();
+
+        /// @brief Mark the end of a frame.
+        static void EndFrame();
+
+        /// @brief Record a finished CPU interval (used by ProfileScope).
+        static void RecordCpu(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+        /// @brief Issue the start timestamp of a GPU pass; returns a handle for EndGpu (or -1).
+        static int BeginGpu(const char *name);
+
+        /// @brief Issue the end timestamp of a GPU pass.
+        static void EndGpu(int handle);
+
+        /// @brief Write the recorded frames as Chrome trace JSON.
+        /// @return If the file was written or not
+        static bool ExportChromeTrace(const std::string &filename);
+
+        /// @brief Delete the GPU queries; call before the GL context is destroyed.
+        static void Shutdown();
+    };
+
+    /// @brief Times the enclosing block on the CPU.
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char *name)
+            : _name(name), _start(std::chrono::steady_clock::now()) {}
+
+        ~ProfileScope()
+        {
+            if (Profiler::IsEnabled())
+                Profiler::RecordCpu(_name, _start, std::chrono::steady_clock::now());
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        const char *_name;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /// @brief Times the GL commands issued in the enclosing block on the GPU.
+    class GpuProfileScope
+    {
+    public:
+        explicit GpuProfileScope(const char *name)
+            : _handle(Profiler::IsEnabled() ? Profiler::BeginGpu(name) : -1) {}
+
+        ~GpuProfileScope()
+        {
+            if (_handle >= 0)
+                Profiler::EndGpu(_handle);
+        }
+
+        GpuProfileScope(const GpuProfileScope &) = delete;
+        GpuProfileScope &operator=(const GpuProfileScope &) = delete;
+
+    private:
+        int _handle;
+    };
+}
+
+#define RA_PROFILE_CONCAT_(a, b) a##b
+#define RA_PROFILE_CONCAT(a, b) RA_PROFILE_CONCAT_(a, b)
+
+/// Times the rest of the enclosing block on the CPU.
+#define RA_PROFILE_SCOPE(name) ::RA::ProfileScope RA_PROFILE_CONCAT(ra_profile_scope_, __LINE__)(name)
+
+/// Times the rest of the enclosing block on the CPU and the GPU.
+#define RA_PROFILE_GPU(name)     \
+    RA_PROFILE_SCOPE(name);      \
+    ::RA::GpuProfileScope RA_PROFILE_CONCAT(ra_profile_gpu_, __LINE__)(name)
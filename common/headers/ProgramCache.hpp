@@ -0,0 +1,71 @@
+#pragma once
+
+// Standard Headers
+#include <iostream>
+#include <string>
+#include <vector>
+// External Headers
+#include <glad/glad.h>
+
+namespace RA
+{
+    /**
+     * @brief Builds GLSL programs and keeps their linked binaries on disk, shared by lab1 and lab2.
+     *
+     * A program is keyed by a hash of its stage sources, the defines and the GL vendor, renderer
+     * and version strings. On a hit the binary is handed to glProgramBinary and no GLSL is compiled;
+     * when the driver rejects it (e.g. after a driver update) the program is compiled from source
+     * and the binary is written again.
+     *
+     * Build only submits the work: compile and link are issued without querying their status, which
+     * lets drivers with GL_KHR_parallel_shader_compile run them on their own threads while the caller
+     * keeps loading. Submitted programs stay pending until Finish, usually on first use, checks their
+     * logs and writes the binary. Every program is timed from submission to completion and the totals
+     * are printed once nothing is pending, so the log shows what the cache and the overlap save.
+     */
+    class ProgramCache
+    {
+    public:
+        /// @brief One shader stage of a program.
+        struct Stage
+        {
+            GLenum Type;        ///< GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+            std::string Source; ///< GLSL source text
+            const char *Label;  ///< Stage name used in error messages ("VERTEX", ...)
+        };
+
+        /// @brief Submit a program, loaded from a binary in the cache or compiled from source.
+        /// @param name Name used in the log
+        /// @param stages The stages of the program
+        /// @param defines Lines inserted after the #version line of every stage, part of the key
+        /// @return The program, pending until Finish
+        static GLuint Build(const std::string &name, const std::vector<Stage> &stages, const std::string &defines = "");
+
+        /// @brief True if Finish would not wait for the driver; always true without parallel compilation,
+        /// which gives no way to ask.
+        static bool IsReady(GLuint program);
+
+        /// @brief Wait for a pending program, print its errors and cache its binary; nothing to do if it is not pending.
+        /// @return If the program linked
+        static bool Finish(GLuint program);
+
+        /// @brief Finish every pending program.
+        static void FinishAll();
+
+        /// @brief Resolve the program binary and parallel compile entry points; call once the GL context is current.
+        /// @param loader The loader GLAD was initialized with; without it programs are always compiled
+        static void Initialize(GLADloadproc loader);
+
+        /// @brief Read a shader source file, exiting with an error message if it cannot be read.
+        static std::string ReadSource(const char *path);
+
+        /// @brief Directory of the binaries ("cache/programs" by default); caching is off when empty.
+        static void SetDirectory(const std::string &directory);
+
+        /// @brief Log every program build with its time.
+        static void SetVerbose(bool verbose);
+
+        /// @brief Print how many programs were built, how many came from the cache and the time spent and waited.
+        static void PrintStats(std::ostream &out = std::cout);
+    };
+}
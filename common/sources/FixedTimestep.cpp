@@ -0,0 +1,41 @@
+// Local Headers
+#include "FixedTimestep.hpp"
+// Standard Headers
+#include <algorithm>
+
+namespace RA
+{
+    FixedTimestep::FixedTimestep(double step, int max_steps)
+        : _step(std::max(step, 1e-6)), _maxSteps(std::max(max_steps, 1))
+    {
+    }
+
+    int FixedTimestep::Advance(double frame_time)
+    {
+        _accumulator += std::max(frame_time, 0.0);
+
+        int steps = static_cast<int>(_accumulator / _step);
+        if (steps > _maxSteps)
+        {
+            // Keep the fractional part so Alpha stays continuous, drop the rest.
+            double excess = (steps - _maxSteps) * _step;
+            _accumulator -= excess;
+            _dropped += excess;
+            steps = _maxSteps;
+        }
+
+        _accumulator -= steps * _step;
+        _ticks += steps;
+        return steps;
+    }
+
+    void FixedTimestep::SetStep(double step)
+    {
+        _step = std::max(step, 1e-6);
+    }
+
+    void FixedTimestep::SetMaxSteps(int max_steps)
+    {
+        _maxSteps = std::max(max_steps, 1);
+    }
+}
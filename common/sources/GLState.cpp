@@ -0,0 +1,317 @@
+// Local Headers
+#include "GLState.hpp"
+// Standard Headers
+#include <algorithm>
+#include <vector>
+
+namespace RA
+{
+    namespace
+    {
+        constexpr GLuint UNKNOWN = ~0u;
+
+        struct BufferBinding
+        {
+            GLenum Target;
+            GLuint Index; ///< UNKNOWN for the generic (non-indexed) binding
+            GLuint Buffer;
+        };
+
+        struct TextureBinding
+        {
+            GLuint Unit;
+            GLenum Target;
+            GLuint Texture;
+        };
+
+        struct CapabilityState
+        {
+            GLenum Capability;
+            bool Enabled;
+        };
+
+        /// Cached state of the current context. Unknown values are simply absent or UNKNOWN.
+        struct State
+        {
+            GLuint Program = UNKNOWN;
+            GLuint VertexArray = UNKNOWN;
+            GLuint ActiveUnit = UNKNOWN;
+            std::vector<BufferBinding> Buffers;
+            std::vector<TextureBinding> Textures;
+            std::vector<CapabilityState> Capabilities;
+
+            int DepthMask = -1;
+            GLenum DepthFunc = UNKNOWN;
+            GLenum BlendSource = UNKNOWN;
+            GLenum BlendDestination = UNKNOWN;
+            float LineWidth = -1.0f;
+            GLenum PolygonMode = UNKNOWN;
+
+            GLState::CallStats Stats[GLState::COUNTER_COUNT];
+        };
+
+        State &Current()
+        {
+            static State state;
+            return state;
+        }
+
+        /// Counts a request and returns true if it changes the cached value.
+        bool Request(GLState::Counter counter, bool changed)
+        {
+            GLState::CallStats &stats = Current().Stats[counter];
+            stats.Requested++;
+            if (!changed)
+                stats.Skipped++;
+            return changed;
+        }
+
+        BufferBinding *FindBuffer(GLenum target, GLuint index)
+        {
+            for (BufferBinding &binding : Current().Buffers)
+                if (binding.Target == target && binding.Index == index)
+                    return &binding;
+            return nullptr;
+        }
+
+        /// Returns true if the binding changed.
+        bool SetBuffer(GLenum target, GLuint index, GLuint buffer)
+        {
+            BufferBinding *binding = FindBuffer(target, index);
+            if (binding && binding->Buffer == buffer)
+                return false;
+
+            if (binding)
+                binding->Buffer = buffer;
+            else
+                Current().Buffers.push_back({target, index, buffer});
+            return true;
+        }
+    }
+
+    bool GLState::UseProgram(GLuint program)
+    {
+        State &state = Current();
+        if (!Request(PROGRAM, state.Program != program))
+            return false;
+
+        glUseProgram(program);
+        state.Program = program;
+        return true;
+    }
+
+    bool GLState::BindVertexArray(GLuint vao)
+    {
+        State &state = Current();
+        if (!Request(VERTEX_ARRAY, state.VertexArray != vao))
+            return false;
+
+        glBindVertexArray(vao);
+        state.VertexArray = vao;
+        return true;
+    }
+
+    bool GLState::BindBuffer(GLenum target, GLuint buffer)
+    {
+        // The element buffer binding belongs to the bound VAO, so it cannot be cached globally
+        bool changed = target == GL_ELEMENT_ARRAY_BUFFER || SetBuffer(target, UNKNOWN, buffer);
+        if (!Request(BUFFER, changed))
+            return false;
+
+        glBindBuffer(target, buffer);
+        return true;
+    }
+
+    bool GLState::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        bool changed = SetBuffer(target, index, buffer);
+        if (!Request(BUFFER, changed))
+            return false;
+
+        glBindBufferBase(target, index, buffer);
+        SetBuffer(target, UNKNOWN, buffer);
+        return true;
+    }
+
+    bool GLState::ActiveTexture(GLuint unit)
+    {
+        State &state = Current();
+        if (!Request(TEXTURE, state.ActiveUnit != unit))
+            return false;
+
+        glActiveTexture(GL_TEXTURE0 + unit);
+        state.ActiveUnit = unit;
+        return true;
+    }
+
+    bool GLState::BindTexture(GLuint unit, GLenum target, GLuint texture)
+    {
+        State &state = Current();
+
+        auto binding = std::find_if(state.Textures.begin(), state.Textures.end(), [&](const TextureBinding &b)
+                                    { return b.Unit == unit && b.Target == target; });
+
+        bool changed = binding == state.Textures.end() || binding->Texture != texture;
+        if (!Request(TEXTURE, changed))
+            return false;
+
+        ActiveTexture(unit);
+        glBindTexture(target, texture);
+
+        if (binding == state.Textures.end())
+            state.Textures.push_back({unit, target, texture});
+        else
+            binding->Texture = texture;
+        return true;
+    }
+
+    bool GLState::SetCapability(GLenum capability, bool enabled)
+    {
+        State &state = Current();
+
+        auto cached = std::find_if(state.Capabilities.begin(), state.Capabilities.end(), [&](const CapabilityState &c)
+                                   { return c.Capability == capability; });
+
+        bool changed = cached == state.Capabilities.end() || cached->Enabled != enabled;
+        if (!Request(CAPABILITY, changed))
+            return false;
+
+        if (enabled)
+            glEnable(capability);
+        else
+            glDisable(capability);
+
+        if (cached == state.Capabilities.end())
+            state.Capabilities.push_back({capability, enabled});
+        else
+            cached->Enabled = enabled;
+        return true;
+    }
+
+    bool GLState::DepthMask(bool write)
+    {
+        State &state = Current();
+        if (!Request(DEPTH, state.DepthMask != static_cast<int>(write)))
+            return false;
+
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+        state.DepthMask = static_cast<int>(write);
+        return true;
+    }
+
+    bool GLState::DepthFunc(GLenum func)
+    {
+        State &state = Current();
+        if (!Request(DEPTH, state.DepthFunc != func))
+            return false;
+
+        glDepthFunc(func);
+        state.DepthFunc = func;
+        return true;
+    }
+
+    bool GLState::BlendFunc(GLenum source, GLenum destination)
+    {
+        State &state = Current();
+        if (!Request(BLEND, state.BlendSource != source || state.BlendDestination != destination))
+            return false;
+
+        glBlendFunc(source, destination);
+        state.BlendSource = source;
+        state.BlendDestination = destination;
+        return true;
+    }
+
+    bool GLState::LineWidth(float width)
+    {
+        State &state = Current();
+        if (!Request(RASTER, state.LineWidth != width))
+            return false;
+
+        glLineWidth(width);
+        state.LineWidth = width;
+        return true;
+    }
+
+    bool GLState::PolygonMode(GLenum mode)
+    {
+        State &state = Current();
+        if (!Request(RASTER, state.PolygonMode != mode))
+            return false;
+
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+        state.PolygonMode = mode;
+        return true;
+    }
+
+    GLenum GLState::GetPolygonMode()
+    {
+        GLenum mode = Current().PolygonMode;
+        return mode == UNKNOWN ? GL_FILL : mode;
+    }
+
+    void GLState::DeleteProgram(GLuint program)
+    {
+        if (Current().Program == program)
+            Current().Program = UNKNOWN;
+        glDeleteProgram(program);
+    }
+
+    void GLState::DeleteVertexArray(GLuint vao)
+    {
+        // Deleting the bound VAO reverts the binding to 0
+        if (Current().VertexArray == vao)
+            Current().VertexArray = 0;
+        glDeleteVertexArrays(1, &vao);
+    }
+
+    void GLState::DeleteBuffer(GLuint buffer)
+    {
+        for (BufferBinding &binding : Current().Buffers)
+            if (binding.Buffer == buffer)
+                binding.Buffer = 0;
+        glDeleteBuffers(1, &buffer);
+    }
+
+    void GLState::DeleteTexture(GLuint texture)
+    {
+        for (TextureBinding &binding : Current().Textures)
+            if (binding.Texture == texture)
+                binding.Texture = 0;
+        glDeleteTextures(1, &texture);
+    }
+
+    void GLState::Invalidate()
+    {
+        State &state = Current();
+        CallStats stats[COUNTER_COUNT];
+        std::copy(std::begin(state.Stats), std::end(state.Stats), stats);
+
+        state = State();
+        std::copy(std::begin(stats), std::end(stats), state.Stats);
+    }
+
+    const GLState::CallStats &GLState::GetStats(Counter counter)
+    {
+        return Current().Stats[counter];
+    }
+
+    void GLState::ResetStats()
+    {
+        for (CallStats &stats : Current().Stats)
+            stats = CallStats();
+    }
+
+    void GLState::PrintStats(std::ostream &out)
+    {
+        static const char *names[COUNTER_COUNT] = {"program", "vertex array", "buffer", "texture", "capability", "depth", "blend", "raster"};
+
+        out << "[DEBUG]: GLState redundant calls" << std::endl;
+        for (int i = 0; i < COUNTER_COUNT; i++)
+        {
+            const CallStats &stats = Current().Stats[i];
+            out << "    " << names[i] << ": " << stats.Skipped << "/" << stats.Requested << " skipped ("
+                << static_cast<int>(stats.RedundantRate() * 100.0 + 0.5) << "%)" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,287 @@
+// Local Headers
+#include "JobSystem.hpp"
+// Standard Headers
+#include <algorithm>
+
+namespace RA
+{
+    namespace
+    {
+        /// Pool and queue of the current worker thread, so nested jobs go to the local queue.
+        thread_local const JobSystem *CurrentSystem = nullptr;
+        thread_local size_t CurrentQueue = 0;
+    }
+
+    JobSystem::Handle::Handle(Counter *counter)
+        : _counter(counter)
+    {
+        _Retain(_counter);
+    }
+
+    JobSystem::Handle::Handle(const Handle &other)
+        : _counter(other._counter)
+    {
+        if (_counter)
+            _Retain(_counter);
+    }
+
+    JobSystem::Handle::Handle(Handle &&other) noexcept
+        : _counter(other._counter)
+    {
+        other._counter = nullptr;
+    }
+
+    JobSystem::Handle &JobSystem::Handle::operator=(Handle other) noexcept
+    {
+        std::swap(_counter, other._counter);
+        return *this;
+    }
+
+    JobSystem::Handle::~Handle()
+    {
+        if (_counter)
+            _Release(_counter);
+    }
+
+    bool JobSystem::Handle::IsDone() const
+    {
+        return !_counter || _counter->Pending.load(std::memory_order_acquire) == 0;
+    }
+
+    JobSystem::CounterPool &JobSystem::_Pool()
+    {
+        static CounterPool pool;
+        return pool;
+    }
+
+    JobSystem::Counter *JobSystem::_AcquireCounter(int pending)
+    {
+        CounterPool &pool = _Pool();
+        std::lock_guard<std::mutex> lock(pool.Mutex);
+
+        if (pool.Free.empty())
+        {
+            pool.Counters.push_back(std::make_unique<Counter>());
+            pool.Free.push_back(pool.Counters.back().get());
+
+            // Room for every counter, so releasing one never allocates
+            pool.Free.reserve(pool.Counters.size());
+        }
+
+        Counter *counter = pool.Free.back();
+        pool.Free.pop_back();
+        counter->Pending.store(pending, std::memory_order_relaxed);
+        return counter;
+    }
+
+    void JobSystem::_Retain(Counter *counter)
+    {
+        counter->References.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void JobSystem::_Release(Counter *counter)
+    {
+        if (counter->References.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        CounterPool &pool = _Pool();
+        std::lock_guard<std::mutex> lock(pool.Mutex);
+        pool.Free.push_back(counter);
+    }
+
+    void JobSystem::Queue::PushBack(Task task)
+    {
+        if (Count == Tasks.size())
+        {
+            // Grow geometrically and unwrap the ring, front first
+            std::vector<Task> grown(std::max<size_t>(16, Tasks.size() * 2));
+            for (size_t i = 0; i < Count; i++)
+                grown[i] = std::move(Tasks[(Head + i) % Tasks.size()]);
+            Tasks.swap(grown);
+            Head = 0;
+        }
+
+        Tasks[(Head + Count) % Tasks.size()] = std::move(task);
+        Count++;
+    }
+
+    void JobSystem::Queue::PopBack(Task &task)
+    {
+        Count--;
+        task = std::move(Tasks[(Head + Count) % Tasks.size()]);
+    }
+
+    void JobSystem::Queue::PopFront(Task &task)
+    {
+        task = std::move(Tasks[Head]);
+        Head = (Head + 1) % Tasks.size();
+        Count--;
+    }
+
+    JobSystem::JobSystem(unsigned workers)
+    {
+        if (workers == 0)
+            workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+        for (unsigned i = 0; i <= workers; i++)
+            _queues.push_back(std::make_unique<Queue>());
+
+        _workers.reserve(workers);
+        for (unsigned i = 0; i < workers; i++)
+            _workers.emplace_back([this, i]()
+                                  { _WorkerLoop(i + 1); });
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+
+        for (std::thread &worker : _workers)
+            worker.join();
+
+        // Workers leave once the queues are empty, but jobs submitted from outside without a wait may remain
+        while (_RunOne(0))
+            ;
+    }
+
+    JobSystem::Handle JobSystem::Submit(Job job)
+    {
+        Handle handle(_AcquireCounter(1));
+        _Retain(handle._counter);
+        _Push(_CurrentQueue(), {std::move(job), handle._counter});
+        return handle;
+    }
+
+    void JobSystem::Wait(const Handle &handle)
+    {
+        if (handle._counter)
+            _Wait(handle._counter);
+    }
+
+    void JobSystem::_Wait(const Counter *counter)
+    {
+        size_t queue = _CurrentQueue();
+        while (counter->Pending.load(std::memory_order_acquire) != 0)
+        {
+            if (!_RunOne(queue))
+                std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::_ParallelFor(size_t count, size_t batch, BatchFunction call, const void *function)
+    {
+        if (count == 0)
+            return;
+
+        batch = std::max<size_t>(batch, 1);
+        size_t batches = (count + batch - 1) / batch;
+
+        // One counter for all batches; the caller runs the first batch itself
+        Handle pending(_AcquireCounter(static_cast<int>(batches - 1)));
+
+        // A worker keeps the batches local and lets idle workers steal them; an outside
+        // thread deals them round-robin so every worker starts with local work
+        size_t own = _CurrentQueue();
+        for (size_t b = 1; b < batches; b++)
+        {
+            size_t begin = b * batch;
+            size_t end = std::min(count, begin + batch);
+            size_t queue = own != 0 ? own : b % _queues.size();
+            _Retain(pending._counter);
+            _Push(queue, {[call, function, begin, end]()
+                          { call(function, begin, end); },
+                          pending._counter});
+        }
+
+        call(function, 0, std::min(count, batch));
+        Wait(pending);
+    }
+
+    void JobSystem::_WorkerLoop(size_t queue)
+    {
+        CurrentSystem = this;
+        CurrentQueue = queue;
+
+        while (true)
+        {
+            if (_RunOne(queue))
+                continue;
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wake.wait(lock, [this]()
+                       { return _stopping || _queued.load(std::memory_order_acquire) > 0; });
+
+            if (_stopping && _queued.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    size_t JobSystem::_CurrentQueue() const
+    {
+        return CurrentSystem == this ? CurrentQueue : 0;
+    }
+
+    void JobSystem::_Push(size_t queue, Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_queues[queue]->Mutex);
+            _queues[queue]->PushBack(std::move(task));
+        }
+        _queued.fetch_add(1, std::memory_order_release);
+
+        // Taking the sleep lock orders this wake-up after a worker's predicate check
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wake.notify_one();
+    }
+
+    bool JobSystem::_Take(size_t queue, Task &task)
+    {
+        {
+            Queue &own = *_queues[queue];
+            std::lock_guard<std::mutex> lock(own.Mutex);
+            if (own.Count > 0)
+            {
+                // Workers take their newest task, the shared queue is served in order
+                if (queue != 0)
+                    own.PopBack(task);
+                else
+                    own.PopFront(task);
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < _queues.size(); i++)
+        {
+            Queue &victim = *_queues[(queue + i) % _queues.size()];
+            std::lock_guard<std::mutex> lock(victim.Mutex);
+            if (victim.Count > 0)
+            {
+                victim.PopFront(task);
+                _steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool JobSystem::_RunOne(size_t queue)
+    {
+        Task task;
+        if (!_Take(queue, task))
+            return false;
+
+        _queued.fetch_sub(1, std::memory_order_acq_rel);
+        task.Function();
+        task.Function = Job();
+        task.Pending->Pending.fetch_sub(1, std::memory_order_release);
+        _Release(task.Pending);
+        return true;
+    }
+}
@@ -0,0 +1,297 @@
+// Local Headers
+#include "Profiler.hpp"
+// Standard Headers
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RA
+{
+    namespace
+    {
+        constexpr uint64_t NO_FRAME = ~0ull;
+        constexpr int GPU_FRAMES = 2;      ///< Query sets in flight (double buffering)
+        constexpr uint32_t GPU_TRACK = 100; ///< Chrome trace thread id used for GPU events
+
+        /// One interval, in microseconds since the profiler was enabled.
+        struct Event
+        {
+            const char *Name;
+            double Start;
+            double Duration;
+            uint32_t Thread;
+        };
+
+        struct FrameRecord
+        {
+            uint64_t Index = NO_FRAME;
+            double Start = 0.0;
+            double Duration = 0.0;
+            std::vector<Event> Cpu;
+            std::vector<Event> Gpu;
+        };
+
+        struct GpuPass
+        {
+            const char *Name;
+            GLuint Begin;
+            GLuint End;
+        };
+
+        /// Timestamp queries issued during one frame.
+        struct GpuFrame
+        {
+            uint64_t Frame = NO_FRAME;
+            std::vector<GLuint> Queries;
+            size_t Used = 0;
+            std::vector<GpuPass> Passes;
+        };
+
+        struct State
+        {
+            std::atomic<bool> Enabled{false};
+            std::mutex Mutex;
+            std::chrono::steady_clock::time_point Origin;
+
+            uint64_t Frame = NO_FRAME;
+            FrameRecord Frames[Profiler::HISTORY];
+            GpuFrame Gpu[GPU_FRAMES];
+
+            std::vector<std::thread::id> Threads;
+            double GpuOffset = 0.0; ///< CPU microseconds minus GPU microseconds
+            uint64_t DroppedGpu = 0;
+        };
+
+        State &Current()
+        {
+            static State state;
+            return state;
+        }
+
+        double Microseconds(std::chrono::steady_clock::time_point time)
+        {
+            return std::chrono::duration<double, std::micro>(time - Current().Origin).count();
+        }
+
+        uint32_t ThreadIndex(std::thread::id id)
+        {
+            std::vector<std::thread::id> &threads = Current().Threads;
+            auto it = std::find(threads.begin(), threads.end(), id);
+            if (it != threads.end())
+                return static_cast<uint32_t>(it - threads.begin());
+
+            threads.push_back(id);
+            return static_cast<uint32_t>(threads.size() - 1);
+        }
+
+        /// Reads back the finished passes of an old frame; passes whose results are not ready are dropped, never waited for.
+        void ResolveGpu(GpuFrame &gpu)
+        {
+            State &state = Current();
+            if (gpu.Frame == NO_FRAME)
+                return;
+
+            FrameRecord &record = state.Frames[gpu.Frame % Profiler::HISTORY];
+            bool keep = record.Index == gpu.Frame;
+
+            for (const GpuPass &pass : gpu.Passes)
+            {
+                GLint available = 0;
+                glGetQueryObjectiv(pass.End, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                {
+                    state.DroppedGpu++;
+                    continue;
+                }
+
+                GLuint64 begin = 0, end = 0;
+                glGetQueryObjectui64v(pass.Begin, GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(pass.End, GL_QUERY_RESULT, &end);
+
+                if (keep)
+                    record.Gpu.push_back({pass.Name, begin / 1000.0 + state.GpuOffset, (end - begin) / 1000.0, GPU_TRACK});
+            }
+
+            gpu.Passes.clear();
+            gpu.Used = 0;
+        }
+    }
+
+    void Profiler::Enable()
+    {
+        State &state = Current();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        if (state.Enabled)
+            return;
+
+        state.Origin = std::chrono::steady_clock::now();
+
+        // One synchronous read to map GPU timestamps onto the CPU timeline
+        GLint64 gpu_now = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+        state.GpuOffset = Microseconds(std::chrono::steady_clock::now()) - gpu_now / 1000.0;
+
+        state.Enabled = true;
+    }
+
+    bool Profiler::IsEnabled()
+    {
+        return Current().Enabled;
+    }
+
+    void Profiler::BeginFrame()
+    {
+        State &state = Current();
+        if (!state.Enabled)
+            return;
+
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        state.Frame = state.Frame == NO_FRAME ? 0 : state.Frame + 1;
+
+        FrameRecord &record = state.Frames[state.Frame % HISTORY];
+        record.Index = state.Frame;
+        record.Start = Microseconds(std::chrono::steady_clock::now());
+        record.Duration = 0.0;
+        record.Cpu.clear();
+        record.Gpu.clear();
+
+        // This query set was last used GPU_FRAMES frames ago, so its results are normally ready
+        GpuFrame &gpu = state.Gpu[state.Frame % GPU_FRAMES];
+        ResolveGpu(gpu);
+        gpu.Frame = state.Frame;
+    }
+
+    void Profiler::EndFrame()
+    {
+        State &state = Current();
+        if (!state.Enabled || state.Frame == NO_FRAME)
+            return;
+
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        FrameRecord &record = state.Frames[state.Frame % HISTORY];
+        record.Duration = Microseconds(std::chrono::steady_clock::now()) - record.Start;
+    }
+
+    void Profiler::RecordCpu(const char *name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        State &state = Current();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        if (state.Frame == NO_FRAME)
+            return;
+
+        double begin = Microseconds(start);
+        state.Frames[state.Frame % HISTORY].Cpu.push_back({name, begin, Microseconds(end) - begin, ThreadIndex(std::this_thread::get_id())});
+    }
+
+    int Profiler::BeginGpu(const char *name)
+    {
+        State &state = Current();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        if (state.Frame == NO_FRAME)
+            return -1;
+
+        GpuFrame &gpu = state.Gpu[state.Frame % GPU_FRAMES];
+        if (gpu.Used + 2 > gpu.Queries.size())
+        {
+            size_t old_size = gpu.Queries.size();
+            gpu.Queries.resize(std::max<size_t>(8, old_size * 2));
+            glGenQueries(static_cast<GLsizei>(gpu.Queries.size() - old_size), gpu.Queries.data() + old_size);
+        }
+
+        GpuPass pass = {name, gpu.Queries[gpu.Used], gpu.Queries[gpu.Used + 1]};
+        gpu.Used += 2;
+
+        glQueryCounter(pass.Begin, GL_TIMESTAMP);
+        gpu.Passes.push_back(pass);
+        return static_cast<int>(gpu.Passes.size() - 1);
+    }
+
+    void Profiler::EndGpu(int handle)
+    {
+        State &state = Current();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        GpuFrame &gpu = state.Gpu[state.Frame % GPU_FRAMES];
+        if (handle < 0 || handle >= static_cast<int>(gpu.Passes.size()))
+            return;
+
+        glQueryCounter(gpu.Passes[handle].End, GL_TIMESTAMP);
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string &filename)
+    {
+        State &state = Current();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "[ERROR] Failed to create trace file: " << filename << std::endl;
+            return false;
+        }
+
+        std::vector<const FrameRecord *> frames;
+        for (const FrameRecord &record : state.Frames)
+            if (record.Index != NO_FRAME)
+                frames.push_back(&record);
+        std::sort(frames.begin(), frames.end(), [](const FrameRecord *a, const FrameRecord *b)
+                  { return a->Index < b->Index; });
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPU_TRACK << ",\"args\":{\"name\":\"GPU\"}}";
+        for (size_t i = 0; i < state.Threads.size(); i++)
+            file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"" << (i == 0 ? "Main" : "Worker " + std::to_string(i)) << "\"}}";
+
+        auto write = [&](const char *name, double start, double duration, uint32_t thread)
+        {
+            file << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+                 << ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+        };
+
+        file.setf(std::ios::fixed);
+        file.precision(3);
+
+        for (const FrameRecord *record : frames)
+        {
+            if (record->Duration > 0.0)
+                write("Frame", record->Start, record->Duration, 0);
+            for (const Event &event : record->Cpu)
+                write(event.Name, event.Start, event.Duration, event.Thread);
+            for (const Event &event : record->Gpu)
+                write(event.Name, event.Start, event.Duration, event.Thread);
+        }
+
+        file << "\n]}\n";
+
+        std::cout << "[DEBUG]: Wrote " << frames.size() << " profiled frames to " << filename;
+        if (state.DroppedGpu > 0)
+            std::cout << " (" << state.DroppedGpu << " GPU timings were not ready in time and were dropped)";
+        std::cout << std::endl;
+
+        return static_cast<bool>(file);
+    }
+
+    void Profiler::Shutdown()
+    {
+        State &state = Current();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+
+        for (GpuFrame &gpu : state.Gpu)
+        {
+            if (!gpu.Queries.empty())
+                glDeleteQueries(static_cast<GLsizei>(gpu.Queries.size()), gpu.Queries.data());
+            gpu = GpuFrame();
+        }
+
+        state.Enabled = false;
+    }
+}
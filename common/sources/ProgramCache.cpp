@@ -0,0 +1,429 @@
+// Local Headers
+#include "ProgramCache.hpp"
+// Standard Headers
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace RA
+{
+    namespace
+    {
+        // GL_ARB_get_program_binary (core in 4.1). lab1 loads a GL 3.3 core profile, whose loader
+        // has none of these, so the entry points are resolved here through the loader of the window.
+        constexpr GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+        constexpr GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+        constexpr GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+
+        // GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile, in neither loader.
+        constexpr GLenum COMPLETION_STATUS = 0x91B1;
+
+        using GetProgramBinaryProc = void(APIENTRYP)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+        using ProgramBinaryProc = void(APIENTRYP)(GLuint, GLenum, const void *, GLsizei);
+        using ProgramParameteriProc = void(APIENTRYP)(GLuint, GLenum, GLint);
+        using MaxShaderCompilerThreadsProc = void(APIENTRYP)(GLuint);
+
+        /// Bump when the file layout changes, so old binaries are ignored.
+        constexpr uint32_t CACHE_VERSION = 1;
+
+        /// Start of every binary file; the program binary follows.
+        struct BinaryHeader
+        {
+            char Magic[4];
+            uint32_t Version;
+            uint32_t Format;
+            uint32_t Length;
+        };
+
+        /// A submitted program whose compile and link results have not been checked yet.
+        struct PendingProgram
+        {
+            std::string Name;
+            std::vector<std::pair<GLuint, const char *>> Shaders; ///< Attached stages with their labels, kept for their logs
+            std::string Path;                                     ///< Binary to write once linked, empty without caching
+            bool Cached = false;
+            bool Rejected = false;
+            std::chrono::steady_clock::time_point Submitted;
+        };
+
+        struct CacheState
+        {
+            GetProgramBinaryProc GetProgramBinary = nullptr;
+            ProgramBinaryProc ProgramBinary = nullptr;
+            ProgramParameteriProc ProgramParameteri = nullptr;
+            bool Parallel = false; ///< Can completion be polled without blocking
+            std::string Driver;    ///< Vendor, renderer and version, part of every key
+
+            std::string Directory = "cache/programs";
+            bool Verbose = true;
+
+            std::map<GLuint, PendingProgram> Pending;
+            std::chrono::steady_clock::time_point FirstSubmitted; ///< Start of the current batch of pending programs
+
+            int Programs = 0;
+            int Hits = 0;
+            int Rejected = 0;
+            double Milliseconds = 0.0; ///< Submission to completion, summed over the programs
+            double Waited = 0.0;       ///< Time the main thread blocked on unfinished programs
+        };
+
+        CacheState &State()
+        {
+            static CacheState state;
+            return state;
+        }
+
+        bool BinariesSupported(const CacheState &state)
+        {
+            return state.GetProgramBinary && state.ProgramBinary && state.ProgramParameteri;
+        }
+
+        /// 64-bit FNV-1a, folded over every part of a key.
+        uint64_t Hash(uint64_t hash, const void *data, size_t size)
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; i++)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            return hash;
+        }
+
+        /// Insert the defines after the #version line, which has to stay first.
+        std::string InsertDefines(const std::string &source, const std::string &defines)
+        {
+            if (defines.empty())
+                return source;
+
+            size_t version = source.find("#version");
+            size_t line_end = version == std::string::npos ? std::string::npos : source.find('\n', version);
+            if (line_end == std::string::npos)
+                return defines + "\n" + source;
+            return source.substr(0, line_end + 1) + defines + "\n" + source.substr(line_end + 1);
+        }
+
+        /// Print the log of a failed compile or link, in the format of the shader classes.
+        bool CheckErrors(GLuint object, const char *type, bool program)
+        {
+            int success;
+            char infolog[1024];
+            if (!program)
+            {
+                glGetShaderiv(object, GL_COMPILE_STATUS, &success);
+                if (!success)
+                {
+                    glGetShaderInfoLog(object, 1024, nullptr, infolog);
+                    std::cout << "[ERROR]: Shader compilation error of type: " + std::string(type) + "\n" + infolog << std::endl;
+                }
+            }
+            else
+            {
+                glGetProgramiv(object, GL_LINK_STATUS, &success);
+                if (!success)
+                {
+                    glGetProgramInfoLog(object, 1024, nullptr, infolog);
+                    std::cout << "[ERROR]: Shader linking error of type: " + std::string(type) + "\n" + infolog << std::endl;
+                }
+            }
+            return success != 0;
+        }
+
+        /// Create a program from a cached binary; 0 if there is none or the driver rejects it.
+        GLuint LoadBinary(const CacheState &state, const std::string &path, bool &rejected)
+        {
+            std::error_code error;
+            uintmax_t size = std::filesystem::file_size(path, error);
+            if (error || size < sizeof(BinaryHeader))
+                return 0;
+
+            std::ifstream file(path, std::ios::binary);
+            BinaryHeader header;
+            if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+                std::memcmp(header.Magic, "RAPB", 4) != 0 || header.Version != CACHE_VERSION)
+                return 0;
+
+            // The length comes from the file; a truncated or corrupt one must not size the allocation.
+            if (header.Length == 0 || header.Length != size - sizeof(header))
+                return 0;
+
+            std::vector<char> binary(header.Length);
+            if (!file.read(binary.data(), header.Length))
+                return 0;
+
+            // A binary of another driver version fails the link status instead of raising an error.
+            GLuint program = glCreateProgram();
+            state.ProgramBinary(program, header.Format, binary.data(), static_cast<GLsizei>(header.Length));
+
+            int success;
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if (!success)
+            {
+                glDeleteProgram(program);
+                rejected = true;
+                return 0;
+            }
+            return program;
+        }
+
+        /// Write the binary of a linked program next to its final name and rename it, so a cut off write is never read.
+        void SaveBinary(const CacheState &state, GLuint program, const std::string &path)
+        {
+            GLint length = 0;
+            glGetProgramiv(program, PROGRAM_BINARY_LENGTH, &length);
+            if (length <= 0)
+                return;
+
+            BinaryHeader header;
+            std::memcpy(header.Magic, "RAPB", 4);
+            header.Version = CACHE_VERSION;
+
+            std::vector<char> binary(length);
+            GLenum format = 0;
+            state.GetProgramBinary(program, length, nullptr, &format, binary.data());
+            header.Format = format;
+            header.Length = static_cast<uint32_t>(length);
+
+            std::error_code error;
+            std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+            std::string temporary = path + ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+                file.write(binary.data(), binary.size());
+                if (!file)
+                {
+                    std::cerr << "[WARNING]: Could not write the program cache " << path << "." << std::endl;
+                    return;
+                }
+            }
+            std::filesystem::rename(temporary, path, error);
+        }
+    }
+
+    void ProgramCache::Initialize(GLADloadproc loader)
+    {
+        CacheState &state = State();
+
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+        {
+            const GLubyte *text = glGetString(name);
+            state.Driver += text ? reinterpret_cast<const char *>(text) : "";
+            state.Driver += '\n';
+        }
+
+        // Binaries are core since 4.1; older contexts may still expose the extension.
+        bool binaries = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+        const char *threads_function = nullptr;
+        GLint extensions = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensions);
+        for (GLint i = 0; i < extensions; i++)
+        {
+            const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+            if (!extension)
+                continue;
+            if (std::strcmp(extension, "GL_ARB_get_program_binary") == 0)
+                binaries = true;
+            else if (std::strcmp(extension, "GL_KHR_parallel_shader_compile") == 0)
+                threads_function = "glMaxShaderCompilerThreadsKHR";
+            else if (std::strcmp(extension, "GL_ARB_parallel_shader_compile") == 0 && !threads_function)
+                threads_function = "glMaxShaderCompilerThreadsARB";
+        }
+
+        // Drivers may support the functions but no binary format at all.
+        GLint formats = 0;
+        if (binaries)
+            glGetIntegerv(NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+        if (binaries && formats > 0 && loader)
+        {
+            state.GetProgramBinary = reinterpret_cast<GetProgramBinaryProc>(loader("glGetProgramBinary"));
+            state.ProgramBinary = reinterpret_cast<ProgramBinaryProc>(loader("glProgramBinary"));
+            state.ProgramParameteri = reinterpret_cast<ProgramParameteriProc>(loader("glProgramParameteri"));
+        }
+
+        // Leave one hardware thread to the application, which keeps loading meanwhile.
+        auto max_threads = threads_function && loader ? reinterpret_cast<MaxShaderCompilerThreadsProc>(loader(threads_function)) : nullptr;
+        if (max_threads)
+        {
+            unsigned hardware = std::thread::hardware_concurrency();
+            max_threads(hardware > 1 ? hardware - 1 : 0xFFFFFFFFu);
+            state.Parallel = true;
+        }
+        else
+            std::cout << "[WARNING]: Parallel shader compilation is not supported, programs are waited on when first used." << std::endl;
+
+        if (!BinariesSupported(state))
+            std::cout << "[WARNING]: Program binaries are not supported, shaders are compiled on every launch." << std::endl;
+    }
+
+    std::string ProgramCache::ReadSource(const char *path)
+    {
+        std::ifstream file;
+        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try
+        {
+            file.open(path);
+            std::stringstream stream;
+            stream << file.rdbuf();
+            return stream.str();
+        }
+        catch (std::ifstream::failure &e)
+        {
+            std::cout << "[ERROR]: Shader file " << path << " could not be read successfully." << std::endl;
+            exit(1);
+        }
+    }
+
+    GLuint ProgramCache::Build(const std::string &name, const std::vector<Stage> &stages, const std::string &defines)
+    {
+        CacheState &state = State();
+        auto start = std::chrono::steady_clock::now();
+        if (state.Pending.empty())
+            state.FirstSubmitted = start;
+
+        std::vector<std::string> sources;
+        for (const Stage &stage : stages)
+            sources.push_back(InsertDefines(stage.Source, defines));
+
+        PendingProgram pending;
+        pending.Name = name;
+        pending.Submitted = start;
+
+        // The key covers everything the binary depends on: the sources, their stages and the driver.
+        if (BinariesSupported(state) && !state.Directory.empty())
+        {
+            uint64_t key = 14695981039346656037ull;
+            key = Hash(key, state.Driver.data(), state.Driver.size());
+            key = Hash(key, &CACHE_VERSION, sizeof(CACHE_VERSION));
+            for (size_t i = 0; i < stages.size(); i++)
+            {
+                key = Hash(key, &stages[i].Type, sizeof(stages[i].Type));
+                key = Hash(key, sources[i].data(), sources[i].size() + 1);
+            }
+
+            char file[21];
+            std::snprintf(file, sizeof(file), "%016llx.bin", static_cast<unsigned long long>(key));
+            pending.Path = state.Directory + "/" + file;
+        }
+
+        GLuint program = pending.Path.empty() ? 0 : LoadBinary(state, pending.Path, pending.Rejected);
+        pending.Cached = program != 0;
+
+        // Compile and link without asking for the results, which would wait for them; Finish checks them.
+        if (!pending.Cached)
+        {
+            program = glCreateProgram();
+            if (!pending.Path.empty())
+                state.ProgramParameteri(program, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+            for (size_t i = 0; i < stages.size(); i++)
+            {
+                const char *code = sources[i].c_str();
+                GLuint shader = glCreateShader(stages[i].Type);
+                glShaderSource(shader, 1, &code, NULL);
+                glCompileShader(shader);
+                glAttachShader(program, shader);
+                pending.Shaders.emplace_back(shader, stages[i].Label);
+            }
+            glLinkProgram(program);
+        }
+
+        state.Pending[program] = std::move(pending);
+        return program;
+    }
+
+    bool ProgramCache::IsReady(GLuint program)
+    {
+        CacheState &state = State();
+        auto pending = state.Pending.find(program);
+        if (pending == state.Pending.end() || pending->second.Cached || !state.Parallel)
+            return true;
+
+        GLint done = GL_FALSE;
+        glGetProgramiv(program, COMPLETION_STATUS, &done);
+        return done != GL_FALSE;
+    }
+
+    bool ProgramCache::Finish(GLuint program)
+    {
+        CacheState &state = State();
+        auto found = state.Pending.find(program);
+        if (found == state.Pending.end())
+        {
+            GLint linked = GL_FALSE;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            return linked != GL_FALSE;
+        }
+
+        PendingProgram pending = std::move(found->second);
+        state.Pending.erase(found);
+
+        auto wait_start = std::chrono::steady_clock::now();
+
+        // The status queries block until the driver threads are done with the program.
+        bool compiled = true;
+        for (const auto &shader : pending.Shaders)
+            compiled = CheckErrors(shader.first, shader.second, false) && compiled;
+        bool linked = CheckErrors(program, "PROGRAM", true);
+
+        // Shaders are deleted (they're attached to the program and are no longer necessary).
+        for (const auto &shader : pending.Shaders)
+            glDeleteShader(shader.first);
+
+        if (!pending.Cached && compiled && linked && !pending.Path.empty())
+            SaveBinary(state, program, pending.Path);
+
+        auto now = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(now - pending.Submitted).count();
+        double waited = std::chrono::duration<double, std::milli>(now - wait_start).count();
+        state.Programs++;
+        state.Hits += pending.Cached ? 1 : 0;
+        state.Rejected += pending.Rejected ? 1 : 0;
+        state.Milliseconds += ms;
+        state.Waited += waited;
+
+        if (state.Verbose)
+            std::cout << "[DEBUG]: Program " << pending.Name
+                      << (pending.Cached ? " loaded from the cache" : pending.Rejected ? " recompiled, cached binary rejected" : " compiled")
+                      << ", ready " << ms << " ms after submission (waited " << waited << " ms)" << std::endl;
+
+        if (state.Pending.empty())
+        {
+            double total = std::chrono::duration<double, std::milli>(now - state.FirstSubmitted).count();
+            std::cout << "[DEBUG]: All programs ready " << total << " ms after the first was submitted" << std::endl;
+            PrintStats();
+        }
+        return linked;
+    }
+
+    void ProgramCache::FinishAll()
+    {
+        CacheState &state = State();
+        while (!state.Pending.empty())
+            Finish(state.Pending.begin()->first);
+    }
+
+    void ProgramCache::SetDirectory(const std::string &directory)
+    {
+        State().Directory = directory;
+    }
+
+    void ProgramCache::SetVerbose(bool verbose)
+    {
+        State().Verbose = verbose;
+    }
+
+    void ProgramCache::PrintStats(std::ostream &out)
+    {
+        const CacheState &state = State();
+        out << "[DEBUG]: " << state.Programs << " programs built (" << state.Milliseconds << " ms summed over the programs, "
+            << state.Waited << " ms waited), " << state.Hits << " from the program cache, " << state.Rejected
+            << " rejected binaries, " << state.Pending.size() << " pending" << std::endl;
+    }
+}
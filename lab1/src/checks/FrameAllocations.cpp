@@ -0,0 +1,85 @@
+// Local Headers
+#include "Application.hpp"
+#include "Assets.hpp"
+// Standard Headers
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Runs the frames of Application with counting allocation functions and fails if the frame loop allocates.
+// Built as LAB1_FRAME_ALLOCATIONS only, so LAB1 keeps the standard allocation functions.
+
+namespace
+{
+    // Allocation counters; the operators below count only while the frames are measured.
+    std::atomic<bool> CountAllocations{false};
+    std::atomic<size_t> Allocations{0};
+    std::atomic<size_t> AllocatedBytes{0};
+}
+
+void *operator new(std::size_t size)
+{
+    if (CountAllocations.load(std::memory_order_relaxed))
+    {
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+        AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    if (void *memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+using namespace RA;
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cout << "[ERROR]: Usage: LAB1_FRAME_ALLOCATIONS <object_file.obj> <curve_file.crv> [frames]\n";
+        return 1;
+    }
+
+    Assets::MeshFile = argv[1];
+    Assets::CurveFile = argv[2];
+    const int FRAMES = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 100;
+
+    // The first frames grow the queues, the job pool and the GPU buffers, which may allocate
+    const int WARMUP = 10;
+
+    // A fixed frame time, so every frame runs simulation steps; the follow key is held, which switches following on
+    const float DELTA_TIME = 1.0f / 120.0f;
+
+    Application application;
+    application.Open();
+
+    for (int i = 0; i < WARMUP; i++)
+        application.Frame(DELTA_TIME, true);
+
+    CountAllocations = true;
+    for (int i = 0; i < FRAMES; i++)
+        application.Frame(DELTA_TIME, true);
+    CountAllocations = false;
+
+    size_t count = Allocations;
+    std::cout << "[BENCH]: " << FRAMES << " frames, " << count << " allocations (" << AllocatedBytes << " bytes)" << std::endl;
+
+    if (count > 0)
+    {
+        std::cout << "[ERROR]: The frame loop allocated " << count << " times, expected none" << std::endl;
+        return 1;
+    }
+    return 0;
+}
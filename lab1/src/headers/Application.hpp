@@ -3,14 +3,20 @@
 // Local headers
 #include "Assets.hpp"
 #include "Camera.hpp"
+#include "FixedTimestep.hpp"
 #include "Input.hpp"
+#include "JobSystem.hpp"
+#include "RenderQueue.hpp"
 #include "Renderer.hpp"
+#include "SceneBVH.hpp"
+#include "TransformHierarchy.hpp"
 #include "Window.hpp"
 
 // Standard headers
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 // External headers
 #include <glad/glad.h>
@@ -26,12 +32,23 @@ namespace RA
         /// @brief Singleton instance of the application
         static std::shared_ptr<Application> Instance;
 
+        /// @brief Chrome trace written at exit; profiling is off when empty
+        static std::string TraceFile;
+
         /// @brief Constructor
         Application();
 
         /// @brief Start the application loop
         void Run();
 
+        /// @brief Open the window, load the assets and set up the scene; the first part of Run
+        void Open();
+
+        /// @brief One iteration of the application loop: input, the simulation job, rendering and the buffer swap
+        /// @param deltaTime Time since the previous frame in seconds
+        /// @param follow_key Is the follow toggle key held in this frame
+        void Frame(float deltaTime, bool follow_key);
+
     private:
         std::unique_ptr<Window> _Window;     ///< Main application window
         std::unique_ptr<Renderer> _Renderer; ///< Renderer for drawing
@@ -40,7 +57,50 @@ namespace RA
 
         Camera _Camera; ///< Main camera for the scene
 
+        /// @brief Output of one simulated frame, everything the render stage reads from the simulation
+        struct FrameSnapshot
+        {
+            bool Following = false;             ///< Is the object following the curve
+            SplineFollower Follow;              ///< State of the followed object after the last step
+            float Alpha = 0.0f;                 ///< Interpolation factor between the last two steps
+            std::vector<glm::vec3> TrailPoints; ///< Trail points produced by the steps of this frame
+        };
+
+        std::unique_ptr<JobSystem> _Jobs; ///< Workers running the simulation stage and its batches
+        FrameSnapshot _Snapshots[2];      ///< Front is rendered while the back one is simulated
+        int _Front = 0;                   ///< Index of the snapshot being rendered
+        SplineFollowers _Followers;       ///< Objects moving along the curve; follower 0 is the mesh
+
+        TransformHierarchy _Scene;             ///< World transforms of the scene objects
+        TransformHierarchy::Node _ObjectNode;  ///< Node of the followed mesh
+        TransformHierarchy::Node _TangentNode; ///< Node of the tangent gizmo, child of the mesh node
+
+        FixedTimestep _Timestep = FixedTimestep(1.0 / 120.0, 8); ///< Simulation clock, 120 Hz with at most 8 catch-up steps per frame
+
+        std::unique_ptr<RenderQueue> _Queue; ///< Draw packets of the current frame
+
+        SceneBVH _Culling;             ///< World bounds of the culled objects
+        std::vector<uint8_t> _Visible; ///< Result of the last cull, one flag per object in _Culling
+        int _VisibleCount = 0;         ///< Objects that passed the last cull
+        int _CullObject = 0;           ///< Culling index of the mesh
+        int _CullCurve = 0;            ///< Culling index of the B-spline
+        int _CullTangent = 0;          ///< Culling index of the tangent gizmo
+
+        glm::mat4 _CurveView = glm::mat4(0.0f); ///< View-projection the CPU curve was last sampled for
+        bool _TessellationKey = false;          ///< Tessellation toggle key state in the previous frame
+
+        std::string _Title;       ///< Base window title, the render stats are appended to it
+        char _TitleText[512] = {}; ///< Title with the render stats, formatted without allocating
+        float _StatsTimer = 0.0f; ///< Time since the stats overlay was last refreshed
+        int _StatsFrames = 0;     ///< Frames since the stats overlay was last refreshed
+
         /// @brief Main application loop
         void _Loop();
+
+        /// @brief Simulation stage, runs on a worker while the previous frame is rendered
+        void _Simulate(FrameSnapshot &out, bool follow_key, float delta_time);
+
+        /// @brief Show frame rate and render queue counters in the window title, twice per second
+        void _UpdateStatsOverlay(float delta_time);
     };
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Mesh.hpp"
 #include "Polyline.hpp"
 #include "Shader.hpp"
+#include "Trail.hpp"
 
 // Standard headers
 #include <memory>
@@ -27,12 +28,55 @@ namespace RA
         /// @return Vector of glm::vec3 points
         static std::vector<glm::vec3> LoadCRV(std::string filename);
 
+        /// @brief Load a .crv file, optionally with a 4th per-point time column
+        /// @param filename Path to the .crv file
+        /// @param points Output points (replaced)
+        /// @param times Output per-point times, left empty unless every point has one (may be null)
+        /// @return If the file could be opened or not
+        static bool LoadCRV(const std::string &filename, std::vector<glm::vec3> &points, std::vector<float> *times);
+
+        /*
+            Binary curve format (.crvb), little-endian:
+                char     magic[4]  "CRVB"
+                uint32   version   1
+                uint32   flags     bit 0 = per-point time array present
+                uint32   reserved  0
+                uint64   count     number of points
+                float[3] points[count]
+                float    times[count]   (only if flags & 1)
+        */
+
+        /// @brief Load a binary .crvb file; the point array is copied straight into the output
+        /// @param filename Path to the .crvb file
+        /// @param points Output points (replaced)
+        /// @param times Output per-point times, empty if the file has none (may be null)
+        /// @return If the file was loaded or not
+        static bool LoadCRVB(const std::string &filename, std::vector<glm::vec3> &points, std::vector<float> *times = nullptr);
+
+        /// @brief Save points (and optional times) as a binary .crvb file
+        /// @return If the file was written or not
+        static bool SaveCRVB(const std::string &filename, const std::vector<glm::vec3> &points, const std::vector<float> *times = nullptr);
+
+        /// @brief Load a curve file, picking the format from the extension (.crvb or text .crv)
+        static std::vector<glm::vec3> LoadCurve(const std::string &filename);
+
+        /// @brief Convert a text .crv file into a binary .crvb file
+        /// @return If the conversion succeeded or not
+        static bool ConvertCRV(const std::string &input, const std::string &output);
+
+        /// @brief Print load throughput of the stream parser, the mapped parser and the binary format
+        /// @param filename Path to a text .crv file
+        /// @param iterations Number of timed loads per method
+        static void BenchmarkCRV(const std::string &filename, int iterations = 5);
+
         std::shared_ptr<Shader> ObjectShader;   ///< Shader used for the main object
         std::shared_ptr<Shader> PolylineShader; ///< Shader used for polylines
+        std::shared_ptr<Shader> BSplineShader;  ///< Shader tessellating B-spline segments on the GPU
 
         std::shared_ptr<Mesh> ObjectMesh;        ///< Main object mesh
         std::shared_ptr<BSpline> BSplineCurve;   ///< B-spline curve representation
         std::shared_ptr<Polyline> ObjectTangent; ///< Polyline showing object tangents
+        std::shared_ptr<Trail> ObjectTrail;      ///< Recent positions of the object following the curve
 
         /// @brief Load all assets (meshes, shaders, curves)
         void LoadAssets();
@@ -1,7 +1,11 @@
 #pragma once
 
 // Local Headers
+#include "Bounds.hpp"
+#include "CurveBVH.hpp"
+#include "CurveSampling.hpp"
 #include "Polyline.hpp"
+#include "RenderQueue.hpp"
 
 // Standard Headers
 #include <iostream>
@@ -22,13 +26,37 @@ namespace RA
         /// @param step Sampling step for curve approximation
         BSpline(float step = 0.05f);
 
+        /// @brief Destructor – deletes the GPU tessellation buffers.
+        ~BSpline();
+
         /// @brief Set control points of the B-spline
         /// @param points Vector of 3D points
         void SetControlPoints(const std::vector<glm::vec3> &points);
 
+        /// @brief Set control points of the B-spline, taking ownership of the vector
+        /// @param points Vector of 3D points (moved from)
+        void SetControlPoints(std::vector<glm::vec3> &&points);
+
         /// @brief Get control points of the B-spline
-        /// @return Vector of 3D control points
-        std::vector<glm::vec3> GetControlPoints();
+        /// @return Vector of 3D control points (no copy; valid until the control points change)
+        const std::vector<glm::vec3> &GetControlPoints() const { return _ControlPoints; }
+
+        /// @brief Number of control points
+        int ControlPointCount() const { return static_cast<int>(_ControlPoints.size()); }
+
+        /// @brief Number of cubic segments (control points - 3, or 0 if fewer than 4 points)
+        int SegmentCount() const;
+
+        /// @brief Arc-length table of the curve, rebuilt on the first call after the control points change
+        /// (not safe to call from several threads right after a change)
+        const ArcLengthTable &GetArcLength() const;
+
+        /// @brief Spatial index for closest-point and picking queries, rebuilt on the first call after the
+        /// control points change (not safe to call from several threads right after a change)
+        const CurveBVH &GetSpatialIndex() const;
+
+        /// @brief World-space box around the curve and its control polygon (the box of the control points)
+        const AABB &GetBounds() const { return _Bounds; }
 
         /// @brief Render both the control polygon and the curve
         /// @param shader Shader used for rendering
@@ -36,6 +64,35 @@ namespace RA
         /// @param proj Projection matrix
         void Render(std::shared_ptr<Shader> shader, glm::mat4 view, glm::mat4 proj);
 
+        /// @brief Queue both the control polygon and the curve for drawing
+        /// @param queue Render queue of the frame
+        /// @param shader Shader used for the polylines
+        void Submit(RenderQueue &queue, std::shared_ptr<Shader> shader);
+
+        /// @brief Enable GPU tessellation of the curve (or disable it with nullptr)
+        /// @param shader Shader with the 'bspline' geometry stage; only control points are uploaded,
+        /// and the curve is no longer sampled on the CPU
+        void SetTessellationShader(std::shared_ptr<Shader> shader);
+
+        /// @brief Is the curve tessellated on the GPU (otherwise it is sampled on the CPU)
+        bool IsTessellatedOnGpu() const { return _TessellationShader != nullptr; }
+
+        /// @brief Set the screen-space error the GPU tessellation may make
+        /// @param pixels Maximum chord deviation in pixels
+        void SetTessellationTolerance(float pixels) { _Tolerance = pixels; }
+
+        /// @brief Switch the CPU approximation between adaptive and fixed-step sampling
+        /// @param enabled Adaptive (default) subdivides until the tolerance is met; otherwise the fixed step is used
+        /// @param tolerance Chord and angle limits for the adaptive sampler
+        void SetAdaptiveTessellation(bool enabled, const TessellationTolerance &tolerance = TessellationTolerance());
+
+        /// @brief Re-tessellate the CPU approximation with a screen-space chord tolerance; the view is kept,
+        /// so later control point changes are sampled for it too. Call it when the camera changes.
+        /// @param view_projection Current projection * view matrix
+        /// @param viewport Viewport size in pixels
+        /// @param pixels Maximum chord deviation in pixels
+        void RebuildForView(const glm::mat4 &view_projection, glm::vec2 viewport, float pixels = 0.5f);
+
         /// @brief Compute a point on the curve
         /// @param i Segment index
         /// @param t Parameter along the segment [0,1]
@@ -58,9 +115,35 @@ namespace RA
         Polyline _ControlPolygon;              ///< Visual representation of the control polygon
         Polyline _CurveApproximation;          ///< Visual representation of the curve (sampled points)
         std::vector<glm::vec3> _ControlPoints; ///< List of control points
-        float _Step;                           ///< Sampling step for curve approximation
+        std::vector<glm::vec3> _CurvePoints;   ///< Reused buffer of sampled curve points
+        mutable ArcLengthTable _ArcLength;     ///< Cumulative arc length of the curve, built on first use
+        mutable CurveBVH _SpatialIndex;        ///< BVH over the curve segments, built on first use
+        mutable bool _ArcLengthDirty = true;   ///< Control points changed since _ArcLength was built
+        mutable bool _SpatialIndexDirty = true; ///< Control points changed since _SpatialIndex was built
+        AABB _Bounds;                          ///< Box of the control points
+        float _Step;                           ///< Sampling step for curve approximation (fixed-step mode)
+
+        bool _Adaptive = true;                    ///< Use adaptive instead of fixed-step sampling
+        TessellationTolerance _AdaptiveTolerance; ///< Limits for adaptive sampling
+
+        bool _HasView = false;                         ///< Was RebuildForView called; adaptive sampling is then in pixels
+        glm::mat4 _ViewProjection = glm::mat4(1.0f);   ///< View of the last RebuildForView
+        glm::vec2 _Viewport = glm::vec2(0.0f);         ///< Viewport of the last RebuildForView
+        float _ViewTolerance = 0.5f;                   ///< Chord tolerance in pixels of the last RebuildForView
+
+        std::shared_ptr<Shader> _TessellationShader; ///< GPU tessellation shader, null for the CPU path
+        float _Tolerance = 0.5f;                     ///< Screen-space tessellation error in pixels
+        GLuint _TessellationVAO = 0;                 ///< VAO for the control point buffer
+        GLuint _TessellationVBO = 0;                 ///< Control points on the GPU
+        bool _TessellationDirty = true;              ///< Control points changed since the last upload
 
         /// @brief Recalculate the sampled points for rendering the curve
         void _BuildCurveApproximation();
+
+        /// @brief Upload the control points for GPU tessellation
+        void _UploadControlPoints();
+
+        /// @brief Draw the curve with the GPU tessellation shader
+        void _RenderTessellated(const glm::mat4 &view, const glm::mat4 &proj);
     };
 }
\ No newline at end of file
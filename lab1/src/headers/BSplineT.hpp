@@ -0,0 +1,318 @@
+#pragma once
+
+// Local Headers
+#include "CurveSampling.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <vector>
+
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /// @brief Degree value that selects the runtime-degree evaluator.
+    constexpr int DynamicDegree = -1;
+
+    /// @brief Highest degree the runtime-degree evaluator supports.
+    constexpr int MaxDynamicDegree = 15;
+
+    /**
+     * @brief Generic B-spline / NURBS curve evaluator.
+     *
+     * Works with any degree, non-uniform knot vectors and optional weights (rational curves).
+     * For a fixed Degree the Cox-de Boor loops have compile-time bounds and get fully unrolled;
+     * BSplineT<DynamicDegree> takes the degree at runtime instead.
+     *
+     * The curve is exposed per non-degenerate knot span as (segment, t in [0,1]), the same
+     * interface as the cubic BSpline, so SampleCurve and ArcLengthTable work on both.
+     */
+    template <int Degree>
+    class BSplineT
+    {
+        static_assert(Degree == DynamicDegree || (Degree >= 1 && Degree <= MaxDynamicDegree), "Unsupported B-spline degree.");
+
+    public:
+        /// @brief Constructor
+        /// @param degree Degree of the curve, only used by BSplineT<DynamicDegree>.
+        explicit BSplineT(int degree = Degree == DynamicDegree ? 3 : Degree)
+            : _degree(Degree == DynamicDegree ? std::clamp(degree, 1, MaxDynamicDegree) : Degree)
+        {
+        }
+
+        /// @brief Degree of the curve.
+        int GetDegree() const
+        {
+            if constexpr (Degree == DynamicDegree)
+                return _degree;
+            else
+                return Degree;
+        }
+
+        /// @brief Set control points and generate a uniform (unclamped) knot vector, matching the cubic BSpline.
+        /// @param points Vector of 3D control points
+        void SetControlPoints(const std::vector<glm::vec3> &points)
+        {
+            _ControlPoints = points;
+            _Weights.clear();
+
+            _Knots.resize(points.size() + GetDegree() + 1);
+            for (size_t i = 0; i < _Knots.size(); i++)
+                _Knots[i] = static_cast<float>(i);
+
+            _BuildSpans();
+        }
+
+        /// @brief Set control points with an explicit knot vector and optional weights.
+        /// @param points Vector of 3D control points
+        /// @param knots Non-decreasing knot vector of size points.size() + degree + 1
+        /// @param weights Per-point weights (empty for a non-rational curve)
+        /// @return If the data describes a valid curve or not.
+        bool SetControlPoints(const std::vector<glm::vec3> &points, const std::vector<float> &knots, const std::vector<float> &weights = std::vector<float>())
+        {
+            int p = GetDegree();
+
+            if (points.size() < static_cast<size_t>(p + 1) || knots.size() != points.size() + p + 1)
+            {
+                std::cerr << "[WARNING]: B-spline of degree " << p << " with " << points.size() << " points needs " << points.size() + p + 1 << " knots, got " << knots.size() << "." << std::endl;
+                return false;
+            }
+
+            if (!std::is_sorted(knots.begin(), knots.end()))
+            {
+                std::cerr << "[WARNING]: B-spline knot vector is not non-decreasing." << std::endl;
+                return false;
+            }
+
+            if (!weights.empty() && weights.size() != points.size())
+            {
+                std::cerr << "[WARNING]: NURBS weight count does not match control point count." << std::endl;
+                return false;
+            }
+
+            _ControlPoints = points;
+            _Knots = knots;
+            _Weights = weights;
+
+            _BuildSpans();
+            return true;
+        }
+
+        /// @brief Get control points of the curve.
+        const std::vector<glm::vec3> &GetControlPoints() const { return _ControlPoints; }
+
+        /// @brief Get the knot vector of the curve.
+        const std::vector<float> &GetKnots() const { return _Knots; }
+
+        /// @brief Get the weights of the curve (empty if non-rational).
+        const std::vector<float> &GetWeights() const { return _Weights; }
+
+        /// @brief Returns true if the curve has weights.
+        bool IsRational() const { return !_Weights.empty(); }
+
+        /// @brief Number of non-degenerate knot spans inside the valid domain.
+        int SegmentCount() const { return static_cast<int>(_Spans.size()); }
+
+        /// @brief Valid parameter domain [u_p, u_n] of the curve.
+        glm::vec2 GetDomain() const
+        {
+            if (_Spans.empty())
+                return glm::vec2(0.0f);
+            return glm::vec2(_Knots[_Spans.front()], _Knots[_Spans.back() + 1]);
+        }
+
+        /// @brief Compute a point on the curve at a global parameter.
+        /// @param u Parameter inside GetDomain()
+        glm::vec3 Evaluate(float u) const
+        {
+            if (_Spans.empty())
+                return glm::vec3(0);
+
+            return _Evaluate(_FindSpan(u), u, nullptr);
+        }
+
+        /// @brief Compute the derivative dC/du at a global parameter.
+        /// @param u Parameter inside GetDomain()
+        glm::vec3 EvaluateDerivative(float u) const
+        {
+            if (_Spans.empty())
+                return glm::vec3(0);
+
+            glm::vec3 derivative;
+            _Evaluate(_FindSpan(u), u, &derivative);
+            return derivative;
+        }
+
+        /// @brief Compute a point on the curve.
+        /// @param i Segment (knot span) index
+        /// @param t Parameter along the segment [0,1]
+        glm::vec3 GetPoint(int i, float t) const
+        {
+            if (i < 0 || i >= SegmentCount())
+                return glm::vec3(0);
+
+            int span = _Spans[i];
+            return _Evaluate(span, glm::mix(_Knots[span], _Knots[span + 1], t), nullptr);
+        }
+
+        /// @brief Compute the derivative with respect to the segment-local parameter.
+        /// @param i Segment (knot span) index
+        /// @param t Parameter along the segment [0,1]
+        glm::vec3 GetTangent(int i, float t) const
+        {
+            if (i < 0 || i >= SegmentCount())
+                return glm::vec3(0);
+
+            int span = _Spans[i];
+            float length = _Knots[span + 1] - _Knots[span];
+
+            glm::vec3 derivative;
+            _Evaluate(span, glm::mix(_Knots[span], _Knots[span + 1], t), &derivative);
+            return derivative * length;
+        }
+
+    private:
+        static constexpr int _Capacity = (Degree == DynamicDegree ? MaxDynamicDegree : Degree) + 1;
+
+        std::vector<glm::vec3> _ControlPoints; ///< List of control points
+        std::vector<float> _Knots;             ///< Knot vector
+        std::vector<float> _Weights;           ///< Per-point weights, empty if non-rational
+        std::vector<int> _Spans;               ///< Knot indices k with u_k < u_k+1 inside the domain
+        int _degree;                           ///< Runtime degree (equals Degree when fixed)
+
+        /// @brief Collect the non-degenerate knot spans of the valid domain.
+        void _BuildSpans()
+        {
+            _Spans.clear();
+
+            int p = GetDegree();
+            int n = static_cast<int>(_ControlPoints.size());
+            if (n < p + 1)
+                return;
+
+            for (int k = p; k < n; k++)
+            {
+                if (_Knots[k] < _Knots[k + 1])
+                    _Spans.push_back(k);
+            }
+        }
+
+        /// @brief Binary search for the knot span containing u (clamped to the domain).
+        int _FindSpan(float u) const
+        {
+            glm::vec2 domain = GetDomain();
+            if (u <= domain.x)
+                return _Spans.front();
+            if (u >= domain.y)
+                return _Spans.back();
+
+            auto it = std::upper_bound(_Spans.begin(), _Spans.end(), u, [this](float value, int span)
+                                       { return value < _Knots[span]; });
+            return *(it - 1);
+        }
+
+        /*
+            Cox-de Boor triangular scheme (The NURBS Book, A2.2).
+
+            Builds N[0..p] for span k. The last level is built separately so that the
+            degree p-1 functions are still available for the first derivative (A2.3):
+                N'_{k-p+j,p} = p * (N_{k-p+j,p-1} / (u_{k+j} - u_{k-p+j}) - N_{k-p+j+1,p-1} / (u_{k+j+1} - u_{k-p+j+1}))
+        */
+        void _Basis(int k, float u, float *N, float *dN) const
+        {
+            const int p = GetDegree();
+
+            std::array<float, _Capacity> left{};
+            std::array<float, _Capacity> right{};
+
+            N[0] = 1.0f;
+            for (int j = 1; j < p; j++)
+                _BasisLevel(k, u, j, N, left.data(), right.data());
+
+            if (dN)
+            {
+                // N holds degree p-1 functions N[0..p-1] here.
+                for (int j = 0; j <= p; j++)
+                {
+                    float a = 0.0f;
+                    float b = 0.0f;
+                    if (j > 0)
+                    {
+                        float d = _Knots[k + j] - _Knots[k - p + j];
+                        a = d > 0.0f ? N[j - 1] / d : 0.0f;
+                    }
+                    if (j < p)
+                    {
+                        float d = _Knots[k + j + 1] - _Knots[k - p + j + 1];
+                        b = d > 0.0f ? N[j] / d : 0.0f;
+                    }
+                    dN[j] = p * (a - b);
+                }
+            }
+
+            _BasisLevel(k, u, p, N, left.data(), right.data());
+        }
+
+        /// @brief Raise the basis functions in N from degree j-1 to degree j.
+        void _BasisLevel(int k, float u, int j, float *N, float *left, float *right) const
+        {
+            left[j] = u - _Knots[k + 1 - j];
+            right[j] = _Knots[k + j] - u;
+
+            float saved = 0.0f;
+            for (int r = 0; r < j; r++)
+            {
+                float denom = right[r + 1] + left[j - r];
+                float temp = denom != 0.0f ? N[r] / denom : 0.0f;
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            N[j] = saved;
+        }
+
+        /// @brief Evaluate the curve (and optionally dC/du) on a known span.
+        glm::vec3 _Evaluate(int k, float u, glm::vec3 *derivative) const
+        {
+            const int p = GetDegree();
+
+            std::array<float, _Capacity> N{};
+            std::array<float, _Capacity> dN{};
+            _Basis(k, u, N.data(), derivative ? dN.data() : nullptr);
+
+            // Homogeneous accumulation: A = sum(w N P), W = sum(w N).
+            glm::vec3 A(0.0f), dA(0.0f);
+            float W = 0.0f, dW = 0.0f;
+            for (int j = 0; j <= p; j++)
+            {
+                int index = k - p + j;
+                float w = _Weights.empty() ? 1.0f : _Weights[index];
+                const glm::vec3 &P = _ControlPoints[index];
+
+                A += (w * N[j]) * P;
+                W += w * N[j];
+                if (derivative)
+                {
+                    dA += (w * dN[j]) * P;
+                    dW += w * dN[j];
+                }
+            }
+
+            if (W == 0.0f)
+                W = 1.0f;
+
+            glm::vec3 point = A / W;
+
+            // Quotient rule: C' = (A' - W' C) / W.
+            if (derivative)
+                *derivative = (dA - dW * point) / W;
+
+            return point;
+        }
+    };
+
+    /// @brief Runtime-degree B-spline / NURBS curve.
+    using BSplineN = BSplineT<DynamicDegree>;
+}
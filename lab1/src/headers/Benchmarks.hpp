@@ -0,0 +1,41 @@
+#pragma once
+
+// Standard Headers
+#include <cstddef>
+#include <string>
+
+namespace RA
+{
+    /**
+     * @brief Command-line benchmarks of LAB1, run instead of the application with --bench-<name>.
+     *
+     * Run picks the benchmark named by the first argument and passes it the rest; every
+     * benchmark prints its results as [BENCH] lines and needs no window.
+     */
+    class Benchmarks
+    {
+    public:
+        /// @brief Is the first argument a benchmark flag (--bench-...)
+        static bool IsBenchmark(int argc, char *argv[]);
+
+        /// @brief Run the benchmark named by argv[1] with the remaining arguments
+        /// @return Exit code of the program: 0, or 1 for an unknown benchmark or missing arguments
+        static int Run(int argc, char *argv[]);
+
+        /// @brief Print the update cost of many spline followers for a growing number of worker threads
+        /// @param filename Path to a curve file (.crv or .crvb)
+        /// @param count Number of followers
+        /// @param steps Number of timed simulation steps per thread count
+        static void Followers(const std::string &filename, size_t count = 100000, int steps = 200);
+
+        /// @brief Print the cost of composing world matrices of a transform tree: per-object mat4 chains vs. TransformHierarchy
+        /// @param nodes Number of nodes (roots with 8 children per node, 4 levels deep)
+        /// @param iterations Number of timed updates per method
+        static void Transforms(size_t nodes = 100000, int iterations = 50);
+
+        /// @brief Print the cost of frustum culling many boxes: testing every box vs. SceneBVH
+        /// @param count Number of boxes, scattered around the camera
+        /// @param iterations Number of timed culls per method
+        static void Culling(size_t count = 100000, int iterations = 50);
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+// Standard Headers
+#include <cmath>
+#include <limits>
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /// @brief Axis-aligned bounding box; a default constructed box is empty.
+    struct AABB
+    {
+        glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 Max = glm::vec3(-std::numeric_limits<float>::max());
+
+        AABB() = default;
+        AABB(const glm::vec3 &min, const glm::vec3 &max) : Min(min), Max(max) {}
+
+        /// @brief False for an empty box (nothing was added to it).
+        bool Valid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+        glm::vec3 Center() const { return (Min + Max) * 0.5f; }
+        glm::vec3 Extents() const { return (Max - Min) * 0.5f; }
+
+        /// @brief Radius of the sphere around Center() that contains the box.
+        float Radius() const { return glm::length(Extents()); }
+
+        void Expand(const glm::vec3 &point)
+        {
+            Min = glm::min(Min, point);
+            Max = glm::max(Max, point);
+        }
+
+        void Expand(const AABB &box)
+        {
+            Min = glm::min(Min, box.Min);
+            Max = glm::max(Max, box.Max);
+        }
+
+        /// @brief Box of the transformed box, without transforming its 8 corners.
+        /// The extent along each world axis is the sum of the absolute matrix row times the local extents.
+        AABB Transformed(const glm::mat4 &matrix) const
+        {
+            if (!Valid())
+                return AABB();
+
+            glm::vec3 center = glm::vec3(matrix * glm::vec4(Center(), 1.0f));
+            glm::vec3 extents = Extents();
+            glm::vec3 world = glm::abs(glm::vec3(matrix[0])) * extents.x +
+                              glm::abs(glm::vec3(matrix[1])) * extents.y +
+                              glm::abs(glm::vec3(matrix[2])) * extents.z;
+            return AABB(center - world, center + world);
+        }
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+// Standard Headers
+#include <limits>
+#include <vector>
+
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    class JobSystem;
+
+    /// @brief Result of a closest-point or picking query on a curve.
+    struct CurveHit
+    {
+        int Segment = -1;               ///< Segment index, -1 if nothing was found
+        float T = 0.0f;                 ///< Parameter along the segment [0,1]
+        glm::vec3 Point = glm::vec3(0); ///< Point on the curve
+        float Distance = 0.0f;          ///< Distance from the query point (or ray) to the curve
+        float RayDistance = 0.0f;       ///< Distance along the ray to the hit (picking only)
+
+        bool Valid() const { return Segment >= 0; }
+    };
+
+    /**
+     * @brief Bounding volume hierarchy over the segments of a uniform cubic B-spline.
+     *
+     * Each segment lies inside the convex hull of its four control points, so the AABB of those
+     * points bounds it. Queries walk the tree nearest-first, then refine the per-segment answer
+     * with Newton iteration on the cubic (kept in power form for cheap Horner evaluation).
+     */
+    class CurveBVH
+    {
+    public:
+        /// @brief Build the hierarchy from the control points of a cubic B-spline.
+        /// @param control_points Control points (segment i uses points i..i+3)
+        void Build(const std::vector<glm::vec3> &control_points);
+
+        /// @brief Number of indexed segments.
+        int SegmentCount() const { return static_cast<int>(_Segments.size()); }
+
+        /// @brief Find the closest point on the curve to a point.
+        /// @param point Query point
+        /// @param max_distance Ignore curve parts further away than this
+        /// @return Closest hit, invalid if the curve is empty or everything is further than max_distance
+        CurveHit ClosestPoint(const glm::vec3 &point, float max_distance = std::numeric_limits<float>::max()) const;
+
+        /// @brief Pick the curve with a ray, treating the curve as a tube (capsule chain) of a radius.
+        /// @param origin Ray origin
+        /// @param direction Ray direction (does not need to be normalized)
+        /// @param radius Tube radius around the curve
+        /// @return Hit nearest to the ray origin, invalid if the ray misses
+        CurveHit Pick(const glm::vec3 &origin, const glm::vec3 &direction, float radius) const;
+
+        /// @brief Closest-point queries for many points, split over the job pool.
+        /// @param points Query points
+        /// @param out Results, resized to points.size()
+        /// @param jobs Job pool, or nullptr to run on the calling thread
+        void ClosestPoints(const std::vector<glm::vec3> &points, std::vector<CurveHit> &out, JobSystem *jobs = nullptr) const;
+
+    private:
+        /// @brief Cubic segment in power form: P(t) = ((A t + B) t + C) t + D.
+        struct Segment
+        {
+            glm::vec3 A, B, C, D;
+
+            glm::vec3 Point(float t) const { return ((A * t + B) * t + C) * t + D; }
+            glm::vec3 First(float t) const { return (3.0f * A * t + 2.0f * B) * t + C; }
+            glm::vec3 Second(float t) const { return 6.0f * A * t + 2.0f * B; }
+        };
+
+        /// @brief Tree node; leaves have Count > 0 and reference _Order[First .. First+Count).
+        struct Node
+        {
+            glm::vec3 Min, Max;
+            int First; ///< First child index for inner nodes (second is First + 1), first item for leaves
+            int Count; ///< Item count for leaves, 0 for inner nodes
+        };
+
+        std::vector<Segment> _Segments; ///< Power-form segments
+        std::vector<glm::vec3> _Min;    ///< Per-segment AABB minimum
+        std::vector<glm::vec3> _Max;    ///< Per-segment AABB maximum
+        std::vector<int> _Order;        ///< Segment indices ordered by leaf
+        std::vector<Node> _Nodes;       ///< Flat node array, root at index 0
+
+        /// @brief Fill node 'index' with the subtree over _Order[first, first+count).
+        void _BuildNode(int index, int first, int count);
+
+        /// @brief Newton refinement of the closest point on a single segment.
+        CurveHit _ClosestOnSegment(int segment, const glm::vec3 &point) const;
+
+        /// @brief Newton refinement of the closest approach between a ray and a single segment.
+        CurveHit _RayOnSegment(int segment, const glm::vec3 &origin, const glm::vec3 &direction) const;
+    };
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /*
+        Shared sampling helpers for segment-parametrized curves.
+
+        A curve type only needs to provide:
+            int SegmentCount() const;
+            glm::vec3 GetPoint(int segment, float t) const;   // t in [0,1]
+            glm::vec3 GetTangent(int segment, float t) const; // dP/dt, not normalized
+
+        Both the cubic BSpline (matrix fast path) and the generic BSplineT<Degree>
+        satisfy this, so they share one batch sampler and one arc-length table.
+    */
+
+    /// @brief Samples every segment of a curve at a fixed parameter step.
+    /// @param curve The curve to sample.
+    /// @param step Parameter step inside a segment, in (0,1].
+    /// @param out Output buffer; cleared but its capacity is reused.
+    template <typename Curve>
+    void SampleCurve(const Curve &curve, float step, std::vector<glm::vec3> &out)
+    {
+        out.clear();
+
+        int segments = curve.SegmentCount();
+        if (segments <= 0 || step <= 0.0f)
+            return;
+
+        // Same sample count per segment as the old 't += step' loop, but computed once
+        // so float accumulation does not add or drop a sample.
+        int samples = static_cast<int>(1.0f / step + 1e-4f) + 1;
+        out.reserve(static_cast<size_t>(segments) * samples);
+
+        for (int i = 0; i < segments; i++)
+        {
+            for (int s = 0; s < samples; s++)
+            {
+                float t = std::min(1.0f, s * step);
+                out.push_back(curve.GetPoint(i, t));
+            }
+        }
+    }
+
+    /// @brief Tolerances for adaptive curve tessellation.
+    struct TessellationTolerance
+    {
+        float Chord = 0.005f; ///< Maximum distance of the curve from a chord (world units, or pixels when a view is given)
+        float Angle = 5.0f;   ///< Maximum tangent turn across one chord, in degrees
+        int MaxDepth = 8;     ///< Maximum bisection depth per segment (at most 2^MaxDepth chords)
+    };
+
+    namespace detail
+    {
+        /// @brief Maps points into the space the chord tolerance is measured in.
+        struct TessellationSpace
+        {
+            const glm::mat4 *ViewProjection = nullptr;
+            glm::vec2 Viewport = glm::vec2(0.0f);
+
+            /// Returns false if the point is behind the camera (the caller then measures in world space).
+            bool Project(const glm::vec3 &p, glm::vec2 &out) const
+            {
+                glm::vec4 clip = *ViewProjection * glm::vec4(p, 1.0f);
+                if (clip.w <= 1e-6f)
+                    return false;
+                out = (glm::vec2(clip.x, clip.y) / clip.w * 0.5f + 0.5f) * Viewport;
+                return true;
+            }
+
+            /// Distance of m from the chord a-b, in pixels if a view is set and all points are visible.
+            float Deviation(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &m) const
+            {
+                glm::vec2 sa, sb, sm;
+                if (ViewProjection && Project(a, sa) && Project(b, sb) && Project(m, sm))
+                    return DistanceToChord(sa, sb, sm);
+                return DistanceToChord(a, b, m);
+            }
+
+            template <typename V>
+            static float DistanceToChord(const V &a, const V &b, const V &m)
+            {
+                V ab = b - a;
+                float len2 = glm::dot(ab, ab);
+                float t = len2 > 0.0f ? glm::clamp(glm::dot(m - a, ab) / len2, 0.0f, 1.0f) : 0.0f;
+                return glm::length(a + ab * t - m);
+            }
+        };
+
+        /// @brief Recursive bisection of [t0, t1] on one segment; appends the end point of every accepted chord.
+        template <typename Curve>
+        void Subdivide(const Curve &curve, int segment, float t0, float t1,
+                       const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &d0, const glm::vec3 &d1,
+                       const TessellationTolerance &tolerance, float cos_angle, const TessellationSpace &space,
+                       int depth, std::vector<glm::vec3> &out)
+        {
+            float tm = 0.5f * (t0 + t1);
+            glm::vec3 pm = curve.GetPoint(segment, tm);
+            glm::vec3 dm = curve.GetTangent(segment, tm);
+
+            if (depth < tolerance.MaxDepth)
+            {
+                // Split on chord deviation, or when the tangent turns too much (catches S-bends whose midpoint lies on the chord).
+                bool deviates = space.Deviation(p0, p1, pm) > tolerance.Chord;
+
+                float l0 = glm::length(d0);
+                float l1 = glm::length(d1);
+                bool turns = l0 > 0.0f && l1 > 0.0f && glm::dot(d0, d1) < cos_angle * l0 * l1;
+
+                // Always split the first level, so a segment is never judged by a single midpoint.
+                if (deviates || turns || depth == 0)
+                {
+                    Subdivide(curve, segment, t0, tm, p0, pm, d0, dm, tolerance, cos_angle, space, depth + 1, out);
+                    Subdivide(curve, segment, tm, t1, pm, p1, dm, d1, tolerance, cos_angle, space, depth + 1, out);
+                    return;
+                }
+            }
+
+            out.push_back(p1);
+        }
+
+        /// @brief Drops points that lie within the chord tolerance of a longer chord, so straight runs
+        /// spanning many segments collapse to one line. Every dropped point is checked against the
+        /// chord replacing it; runs are capped to keep the pass linear.
+        inline void MergeChords(std::vector<glm::vec3> &points, float chord, const TessellationSpace &space)
+        {
+            constexpr size_t MAX_RUN = 64;
+
+            size_t n = points.size();
+            if (n < 3)
+                return;
+
+            // Compaction in place: slots after 'kept' are not written while a run is open,
+            // so the original points of the run are still there to be checked.
+            size_t start = 0;
+            size_t kept = 1;
+            for (size_t end = 2; end < n; end++)
+            {
+                bool straight = end - start <= MAX_RUN;
+                for (size_t k = start + 1; straight && k < end; k++)
+                    straight = space.Deviation(points[start], points[end], points[k]) <= chord;
+
+                if (!straight)
+                {
+                    points[kept++] = points[end - 1];
+                    start = end - 1;
+                }
+            }
+
+            points[kept++] = points[n - 1];
+            points.resize(kept);
+        }
+    }
+
+    /// @brief Samples a curve with as few points as the tolerances allow: straight spans get one chord,
+    /// tight curls are bisected until every chord is within tolerance, then straight runs are merged across segments.
+    /// @param curve The curve to sample.
+    /// @param tolerance Chord, angle and depth limits.
+    /// @param out Output buffer; cleared but its capacity is reused.
+    /// @param view_projection Optional view-projection matrix; with it the chord tolerance is in pixels.
+    /// @param viewport Viewport size in pixels, used together with view_projection.
+    template <typename Curve>
+    void SampleCurveAdaptive(const Curve &curve, const TessellationTolerance &tolerance, std::vector<glm::vec3> &out,
+                             const glm::mat4 *view_projection = nullptr, glm::vec2 viewport = glm::vec2(0.0f))
+    {
+        out.clear();
+
+        int segments = curve.SegmentCount();
+        if (segments <= 0)
+            return;
+
+        detail::TessellationSpace space;
+        space.ViewProjection = view_projection;
+        space.Viewport = viewport;
+
+        float cos_angle = std::cos(glm::radians(tolerance.Angle));
+
+        out.push_back(curve.GetPoint(0, 0.0f));
+        for (int i = 0; i < segments; i++)
+        {
+            detail::Subdivide(curve, i, 0.0f, 1.0f,
+                              curve.GetPoint(i, 0.0f), curve.GetPoint(i, 1.0f),
+                              curve.GetTangent(i, 0.0f), curve.GetTangent(i, 1.0f),
+                              tolerance, cos_angle, space, 0, out);
+        }
+
+        detail::MergeChords(out, tolerance.Chord, space);
+    }
+
+    /// @brief Cumulative arc-length lookup table for reparametrizing a curve by distance.
+    class ArcLengthTable
+    {
+    public:
+        /// @brief Builds the table by integrating |dP/dt| with Simpson's rule per sub-interval.
+        /// @param curve The curve to measure.
+        /// @param samples_per_segment Number of sub-intervals per curve segment.
+        template <typename Curve>
+        void Build(const Curve &curve, int samples_per_segment = 16)
+        {
+            _lengths.clear();
+            _samples = std::max(1, samples_per_segment);
+            _segments = std::max(0, curve.SegmentCount());
+
+            if (_segments == 0)
+                return;
+
+            _lengths.reserve(static_cast<size_t>(_segments) * _samples + 1);
+            _lengths.push_back(0.0f);
+
+            float total = 0.0f;
+            float h = 1.0f / _samples;
+            for (int i = 0; i < _segments; i++)
+            {
+                for (int s = 0; s < _samples; s++)
+                {
+                    float t0 = s * h;
+                    float t1 = t0 + h;
+                    float a = glm::length(curve.GetTangent(i, t0));
+                    float m = glm::length(curve.GetTangent(i, 0.5f * (t0 + t1)));
+                    float b = glm::length(curve.GetTangent(i, t1));
+                    total += (a + 4.0f * m + b) * h / 6.0f;
+                    _lengths.push_back(total);
+                }
+            }
+        }
+
+        /// @brief Total length of the measured curve.
+        float Length() const { return _lengths.empty() ? 0.0f : _lengths.back(); }
+
+        /// @brief Maps a distance along the curve to a (segment, t) pair.
+        /// @param distance Distance from the start of the curve, clamped to [0, Length()].
+        /// @return Segment index and local parameter in [0,1].
+        std::pair<int, float> Lookup(float distance) const
+        {
+            if (_lengths.size() < 2)
+                return {0, 0.0f};
+
+            distance = glm::clamp(distance, 0.0f, Length());
+
+            // First entry strictly greater than the distance.
+            auto it = std::upper_bound(_lengths.begin(), _lengths.end(), distance);
+            size_t hi = std::min(static_cast<size_t>(it - _lengths.begin()), _lengths.size() - 1);
+            size_t lo = hi - 1;
+
+            float span = _lengths[hi] - _lengths[lo];
+            float f = span > 0.0f ? (distance - _lengths[lo]) / span : 0.0f;
+
+            // Linear interpolation between table entries, then split into segment/local t.
+            float global = (static_cast<float>(lo) + f) / _samples;
+            int segment = std::min(static_cast<int>(global), _segments - 1);
+            return {segment, std::min(1.0f, global - segment)};
+        }
+
+    private:
+        std::vector<float> _lengths; ///< Cumulative length at every table entry
+        int _samples = 1;            ///< Sub-intervals per segment
+        int _segments = 0;           ///< Number of measured segments
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Local Headers
+#include "Bounds.hpp"
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /**
+     * @brief View frustum as six planes, tested against boxes four planes at a time.
+     *
+     * The planes are extracted from projection * view (Gribb/Hartmann) and stored as
+     * structure-of-arrays, padded to 8 with planes every box is inside of, so a box
+     * test is two SSE passes of multiply-adds and no branches.
+     */
+    class Frustum
+    {
+    public:
+        /// @brief Result of a containment test.
+        enum Result
+        {
+            OUTSIDE,   ///< Completely outside of at least one plane
+            INTERSECT, ///< Crosses at least one plane
+            INSIDE     ///< Completely inside all planes
+        };
+
+        Frustum();
+
+        /// @brief Extract the planes of a view-projection matrix.
+        /// @param view_projection Projection * view matrix
+        explicit Frustum(const glm::mat4 &view_projection);
+
+        /// @brief Test a box given by its center and half extents.
+        Result Test(const glm::vec3 &center, const glm::vec3 &extents) const;
+
+        /// @brief Test an axis-aligned box; empty boxes are outside.
+        Result Test(const AABB &box) const;
+
+        /// @brief Test a sphere.
+        Result Test(const glm::vec3 &center, float radius) const;
+
+    private:
+        static constexpr int PLANES = 8; ///< 6 frustum planes padded to two SIMD groups
+
+        alignas(16) float _nx[PLANES]; ///< Plane normals, x
+        alignas(16) float _ny[PLANES]; ///< Plane normals, y
+        alignas(16) float _nz[PLANES]; ///< Plane normals, z
+        alignas(16) float _d[PLANES];  ///< Plane distances
+    };
+}
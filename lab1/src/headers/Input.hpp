@@ -4,6 +4,9 @@
 #include "Transform.hpp"
 #include "Mesh.hpp"
 #include "BSpline.hpp"
+#include "SplineFollowers.hpp"
+#include "Trail.hpp"
+#include "TransformHierarchy.hpp"
 
 namespace RA
 {
@@ -13,11 +16,29 @@ namespace RA
         // Camera movement
         static void ProcessCameraInput(GLFWwindow *window, float deltaTime, RA::Transform &camera);
 
-        // Follow a B-spline
-        static void ProcessBSplineFollow(GLFWwindow *window, float delta_time, std::shared_ptr<Mesh> mesh, std::shared_ptr<Polyline> front_vec, std::shared_ptr<BSpline> spline);
+        // Read the follow toggle key; GLFW input may only be read on the main thread
+        static bool IsFollowKeyPressed(GLFWwindow *window);
+
+        // Read the key switching the curve between GPU tessellation and CPU sampling; main thread only
+        static bool IsTessellationKeyPressed(GLFWwindow *window);
+
+        // Toggle following on a key press (once per frame, before the simulation steps); followers restart when it turns on
+        static void ProcessFollowToggle(bool key_pressed, SplineFollowers &followers);
+
+        // Is following switched on (simulation side; the render side reads it from the frame snapshot)
+        static bool IsFollowing() { return _Following; }
+
+        // Advance all followers by one simulation step; follower 0 is the controlled object and leaves the trail points
+        static void ProcessBSplineFollow(float delta_time, std::shared_ptr<BSpline> spline, SplineFollowers &followers, JobSystem *jobs = nullptr, std::vector<glm::vec3> *trail_points = nullptr);
+
+        // Place a scene node between the last two simulation steps of the follower (alpha in [0,1]); objects attached below it follow along
+        static void ApplyBSplineFollow(const SplineFollower &follower, float alpha, TransformHierarchy &scene, TransformHierarchy::Node node, std::shared_ptr<BSpline> spline);
 
-        // Helper function
     private:
+        static bool _Following;  // Followers move only while this is on
+        static bool _KeyPressed; // Toggle key state in the previous frame
+
+        // Helper function
         static void _ComputeRotationFromTo(const glm::vec3 &s, const glm::vec3 &e, glm::vec3 &out_axis, float &out_angle);
         static void _PrintAxisDifference(const glm::vec3 &current_front, float delta_time);
     };
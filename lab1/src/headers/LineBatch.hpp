@@ -0,0 +1,80 @@
+#pragma once
+
+// Local Headers
+#include "Renderable.hpp"
+// Standard Headers
+#include <cstdint>
+#include <vector>
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    class Polyline;
+
+    /**
+     * @brief Many thick polylines of different widths and colors drawn with one instanced call.
+     *
+     * The points of all lines are copied on the GPU from each polyline's own buffer into one shared
+     * buffer, each line in a slot of its buffer capacity plus a break point, next to a buffer with
+     * the line index of every point (-1 for unused points). Per-line attributes (model matrix, color,
+     * width) live in a texture buffer the 'polyline' shader reads with texelFetch. While the same
+     * lines are added in the same order, a frame only copies the points that changed.
+     */
+    class LineBatch : public Renderable
+    {
+    public:
+        LineBatch();
+        ~LineBatch();
+
+        LineBatch(const LineBatch &) = delete;
+        LineBatch &operator=(const LineBatch &) = delete;
+
+        /// @brief Remove all lines; the slots of the last draw are kept for the next one.
+        void Clear();
+
+        /// @brief Add a polyline to the next draw (fewer than 2 points adds nothing).
+        /// @param line The polyline, which must stay alive until the draw
+        void Add(Polyline &line);
+
+        /// @brief Number of lines in the batch
+        int LineCount() const { return static_cast<int>(_lines.size()); }
+
+        /// @brief Copy the changed points and draw every line with a single glDrawArraysInstanced.
+        /// @param shader The 'polyline' shader, with VIEW_MAT, PERS_MAT, VIEWPORT and FADE set and
+        /// filled polygons; the line buffer uniforms are set here
+        void Draw(Shader &shader);
+
+        /// @brief Set up the shader state and draw (see Draw).
+        void Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat) override;
+
+    private:
+        /// @brief Texels per line in the attribute buffer: 4 model matrix columns, color, width
+        static constexpr int TEXELS_PER_LINE = 6;
+
+        /// @brief Place of a line in the shared point buffer
+        struct Slot
+        {
+            uint64_t Id;     ///< Polyline::GetId of the line
+            size_t Offset;   ///< First point of the slot
+            size_t Capacity; ///< Points of the slot, without the break point
+            size_t Count;    ///< Points of the line
+        };
+
+        /// @brief Grow the point and index buffers to hold at least the given number of points.
+        void _Reserve(size_t points);
+
+        std::vector<Polyline *> _lines;   ///< Lines of the next draw
+        std::vector<Slot> _slots;         ///< Slots of the last draw, by line index
+        std::vector<Slot> _layout;        ///< Slots of the draw being built
+        std::vector<glm::vec4> _attributes; ///< Per-line attributes, TEXELS_PER_LINE texels each
+        std::vector<float> _indices;      ///< Line indices of a slot being rewritten
+
+        GLuint _pointVBO = 0;        ///< Points of all slots (vec3)
+        GLuint _indexVBO = 0;        ///< Line index of every point (float)
+        GLuint _lineBuffer = 0;      ///< Texture buffer storage for per-line attributes
+        GLuint _lineTexture = 0;     ///< Texture view of _lineBuffer
+        size_t _pointCapacity = 0;   ///< Points _pointVBO and _indexVBO can hold
+        size_t _lineCapacity = 0;    ///< Texels _lineBuffer can hold
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// Standard Headers
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace RA
+{
+    /**
+     * @brief Read-only view of a whole file.
+     *
+     * The file is memory-mapped where possible (Win32 file mapping or POSIX mmap).
+     * If mapping fails the file is read into an owned buffer instead, so callers only
+     * ever see Data()/Size().
+     */
+    class MappedFile
+    {
+    public:
+        /// @brief Open and map a file.
+        /// @param filename Path to the file
+        explicit MappedFile(const std::string &filename);
+
+        /// @brief Unmaps the file.
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /// @brief Returns true if the file was opened.
+        bool IsOpen() const { return _open; }
+
+        /// @brief Pointer to the first byte of the file (may be null for empty files).
+        const char *Data() const { return _data; }
+
+        /// @brief Size of the file in bytes.
+        size_t Size() const { return _size; }
+
+    private:
+        const char *_data = nullptr; ///< Start of the mapped (or buffered) contents
+        size_t _size = 0;            ///< Size of the contents in bytes
+        bool _open = false;          ///< Was the file opened successfully
+        bool _mapped = false;        ///< Is _data a mapping (true) or _buffer (false)
+        std::vector<char> _buffer;   ///< Fallback storage when mapping is unavailable
+
+#ifdef _WIN32
+        void *_file = nullptr;    ///< Win32 file handle
+        void *_mapping = nullptr; ///< Win32 file mapping handle
+#endif
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 // Local Headers
+#include "Bounds.hpp"
 #include "Transform.hpp"
 #include "Renderable.hpp"
 // Standard Headers
@@ -29,6 +30,15 @@ namespace RA
         /// @brief Renders the mesh with the given shader.
         void Mesh::Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat) override;
 
+        /// @brief Queues the mesh as a single indexed draw.
+        void Submit(RenderQueue &queue, std::shared_ptr<Shader> shader) override;
+
+        /// @brief Box around the vertices, in the mesh's own space.
+        const AABB &GetLocalBounds() const { return _bounds; }
+
+        /// @brief Box around the vertices moved by the model matrix.
+        AABB GetWorldBounds() { return _bounds.Transformed(GetModelMatrix()); }
+
         /// @brief Vertices of the mesh. Should not be manually edited.
         std::vector<glm::vec3> Vertices;
 
@@ -54,6 +64,9 @@ namespace RA
         /// @brief Applies a transform to permanantly change positions of vertices.
         void _ApplyTransform(glm::mat4 matrix);
 
+        /// @brief Box around the vertices, kept from _Normalize.
+        AABB _bounds;
+
         bool _mesh_setup = false;
 
         // Updates mesh and sends its data to the GPU.
@@ -1,9 +1,12 @@
 #pragma once
 
 // Local Headers
+#include "Bounds.hpp"
 #include "Renderable.hpp"
 #include "Transform.hpp"
 // Standard Headers
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <string>
 // External Headers
@@ -11,6 +14,15 @@
 
 namespace RA
 {
+    /**
+     * @brief Line strip drawn as screen-space thick segments.
+     *
+     * Each segment is one instance reading two consecutive points from the point buffer;
+     * the vertex shader expands it into a quad of the line width in pixels, and the
+     * fragment shader cuts it to a capsule, which gives round joins and caps.
+     * The points stay in the polyline's own buffer; only the changed ones are uploaded.
+     * A LineBatch draws many polylines at once from copies of these buffers.
+     */
     class Polyline : public Transform, Renderable
     {
     public:
@@ -19,22 +31,77 @@ namespace RA
 
         void Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat) override;
 
-        std::vector<glm::vec3> GetPoints() const;
+        /// @brief Points of the polyline (no copy; valid until the points change).
+        const std::vector<glm::vec3> &GetPoints() const { return _points; }
+
+        /// @brief Box around the points, in the polyline's own space.
+        const AABB &GetLocalBounds();
+
+        /// @brief Box around the points moved by the model matrix.
+        AABB GetWorldBounds();
+
+        /// @brief Queues the polyline; it is drawn together with the other lines of the same shader.
+        void Submit(RenderQueue &queue, std::shared_ptr<Shader> shader) override;
+
+        /// @brief Upload the dirty points to the polyline's own buffer.
+        /// @return Handle of the buffer (tightly packed vec3 points)
+        unsigned int Upload();
+
+        /// @brief Points the GPU buffer can hold.
+        size_t GetCapacity() const { return _capacity; }
+
+        /// @brief Id unique to this polyline, unlike its address, which a later polyline can reuse.
+        uint64_t GetId() const { return _id; }
+
+        /// @brief Points changed since the last call, as [begin, end); the range is reset.
+        /// Used by LineBatch to copy only those points out of the polyline's buffer.
+        std::pair<size_t, size_t> TakeCopyRange();
+
+        /// @brief Line width in pixels.
+        float GetLineSize() const { return _line_size; }
+
+        const glm::vec4 &GetColor() const { return _color; }
+
+        /// @brief Upload the dirty points and draw with a shader that is already bound.
+        /// @param shader The 'polyline' shader, with VIEW_MAT, PERS_MAT, VIEWPORT, FADE and USE_LINE_BUFFER set and
+        /// filled polygons; only the per-line uniforms are set here
+        void Draw(Shader &shader);
+
         bool AddPoint(const glm::vec3 &point, int index = -1);
         bool RemovePoint(int index);
 
-        bool SetPoints(const std::vector<glm::vec3> vec = std::vector<glm::vec3>());
+        /// @brief Move an existing point; only that point is re-uploaded.
+        bool SetPoint(int index, const glm::vec3 &point);
+
+        bool SetPoints(const std::vector<glm::vec3> &vec = std::vector<glm::vec3>());
+
+        /// @brief Replace the points, taking ownership of the vector (moved from).
+        bool SetPoints(std::vector<glm::vec3> &&vec);
 
     private:
         void _SetupPolyline();
 
+        /// @brief Upload the dirty range, growing the GPU buffer geometrically if the points outgrew it.
+        void _UploadPoints();
+
+        /// @brief Extend the dirty range by [begin, end).
+        void _MarkDirty(size_t begin, size_t end);
+
         std::vector<glm::vec3> _points;
 
         // OpenGL buffer handles
         unsigned int _VBO;
 
         bool _setup;
-        float _line_size;
+        size_t _capacity = 0;    ///< Points the GPU buffer can hold
+        size_t _dirty_begin = 0; ///< First point not yet uploaded
+        size_t _dirty_end = 0;   ///< One past the last point not yet uploaded
+        size_t _copy_begin = 0;  ///< First point changed since the last TakeCopyRange
+        size_t _copy_end = 0;    ///< One past the last point changed since the last TakeCopyRange
+        uint64_t _id;            ///< See GetId
+        AABB _bounds;              ///< Box around the points
+        bool _bounds_dirty = false; ///< Points were moved or removed since _bounds was computed
+        float _line_size; ///< Line width in pixels
         glm::vec4 _color;
     };
 }
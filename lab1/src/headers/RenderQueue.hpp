@@ -0,0 +1,109 @@
+#pragma once
+
+// Local Headers
+#include "LineBatch.hpp"
+#include "Shader.hpp"
+// Standard Headers
+#include <functional>
+#include <memory>
+#include <vector>
+// External Headers
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /// @brief Per-frame counters of the render queue.
+    struct RenderStats
+    {
+        int Packets = 0;        ///< Submitted packets (draws, lines and custom draws)
+        int DrawCalls = 0;      ///< Issued draw calls (a custom draw counts as one)
+        int ProgramChanges = 0; ///< glUseProgram calls that reached the driver
+        int VAOChanges = 0;     ///< glBindVertexArray calls that reached the driver
+        int MergedLines = 0;    ///< Polylines drawn by the single draw call of their shader group
+    };
+
+    /**
+     * @brief Collects draw packets for a frame and submits them with few state changes.
+     *
+     * Plain draws are sorted by program and VAO, so GLState can skip most glUseProgram /
+     * glBindVertexArray calls. VIEW_MAT and PERS_MAT are set once per program per frame.
+     * Polylines sharing a shader are merged into one LineBatch draw, which copies only the
+     * changed points out of each polyline's own buffer. Custom draws
+     * (anything needing extra state) run last, in submission order.
+     */
+    class Polyline;
+    class Renderable;
+
+    class RenderQueue
+    {
+    public:
+        /// @brief A single draw of a VAO with a model matrix.
+        struct DrawPacket
+        {
+            std::shared_ptr<Shader> Program;   ///< Shader used for the draw
+            GLuint VAO = 0;                    ///< Vertex array to bind
+            GLenum Mode = GL_TRIANGLES;        ///< Primitive type
+            GLint First = 0;                   ///< First vertex (non-indexed draws)
+            GLsizei Count = 0;                 ///< Number of vertices or indices
+            bool Indexed = false;              ///< Draw GL_UNSIGNED_INT indices from the VAO's element buffer
+            glm::mat4 Model = glm::mat4(1.0f); ///< Value of MODEL_MAT
+        };
+
+        /// @brief Draw callback for packets the queue cannot describe; receives the view and projection matrices.
+        using CustomDraw = std::function<void(const glm::mat4 &, const glm::mat4 &)>;
+
+        RenderQueue() = default;
+
+        RenderQueue(const RenderQueue &) = delete;
+        RenderQueue &operator=(const RenderQueue &) = delete;
+
+        /// @brief Queue a plain draw.
+        void Submit(const DrawPacket &packet);
+
+        /// @brief Queue a polyline; lines with the same shader are drawn with one call.
+        /// @param line The polyline, which must stay alive until Flush
+        void SubmitLine(std::shared_ptr<Shader> shader, Polyline &line);
+
+        /// @brief Queue a draw that sets up its own state.
+        void SubmitCustom(CustomDraw draw);
+
+        /// @brief Queue a renderable drawn with its own Render, in order with the custom draws.
+        /// Unlike a CustomDraw capturing the shader, it does not allocate once the queue has grown.
+        /// @param renderable The renderable, which must stay alive until Flush
+        void SubmitRenderable(Renderable &renderable, std::shared_ptr<Shader> shader);
+
+        /// @brief Draw everything queued this frame and clear the queue.
+        void Flush(const glm::mat4 &view_mat, const glm::mat4 &pers_mat);
+
+        /// @brief Counters of the last Flush.
+        const RenderStats &GetStats() const { return _stats; }
+
+    private:
+        /// @brief Lines drawn with one shader.
+        struct LineGroup
+        {
+            std::shared_ptr<Shader> Program;
+            std::unique_ptr<LineBatch> Batch; ///< Lines of this frame; its buffers are kept between frames
+        };
+
+        /// @brief A custom draw, or a renderable drawing itself if Object is set.
+        struct CustomPacket
+        {
+            CustomDraw Draw;
+            Renderable *Object = nullptr;
+            std::shared_ptr<Shader> Program;
+        };
+
+        /// @brief Bind a program; sets the camera uniforms the first time in a frame.
+        void _UseProgram(Shader &shader, const glm::mat4 &view_mat, const glm::mat4 &pers_mat);
+
+        std::vector<DrawPacket> _packets; ///< Plain draws of this frame
+        std::vector<LineGroup> _lines;    ///< Line groups, kept between frames for their capacity
+        std::vector<CustomPacket> _custom; ///< Custom draws of this frame
+        std::vector<GLuint> _cameraSet;   ///< Programs that already got VIEW_MAT/PERS_MAT this frame
+
+        RenderStats _stats;   ///< Counters of the last Flush
+        RenderStats _current; ///< Counters of the frame being built
+    };
+}
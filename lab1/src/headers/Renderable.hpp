@@ -11,11 +11,16 @@
 
 namespace RA
 {
+    class RenderQueue;
+
     class Renderable
     {
     public:
         virtual void Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat) = 0;
 
+        /// @brief Queue this object for drawing; by default it is queued as a custom draw calling Render.
+        virtual void Submit(RenderQueue &queue, std::shared_ptr<Shader> shader);
+
         Renderable();
 
         ~Renderable();
@@ -0,0 +1,69 @@
+#pragma once
+
+// Local Headers
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+// Standard Headers
+#include <cstdint>
+#include <vector>
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /**
+     * @brief Bounding volume hierarchy over the world bounds of scene objects, for frustum culling.
+     *
+     * Items are added once and get a stable index; moving an item only updates its box, and the
+     * tree is refitted bottom-up instead of rebuilt. Culling skips whole subtrees outside the frustum
+     * and accepts subtrees completely inside it without testing their items.
+     */
+    class SceneBVH
+    {
+    public:
+        /// @brief Add an item; the tree is rebuilt on the next Update.
+        /// @return Index of the item, used with SetBounds and in the Cull output
+        int Add(const AABB &bounds);
+
+        /// @brief Remove all items.
+        void Clear();
+
+        /// @brief Change the world bounds of an item; the tree is refitted on the next Update.
+        void SetBounds(int item, const AABB &bounds);
+
+        /// @brief Number of items.
+        int Size() const { return static_cast<int>(_Bounds.size()); }
+
+        /// @brief Rebuild the tree if items were added, otherwise refit it if bounds changed.
+        void Update();
+
+        /// @brief Mark the items inside or crossing the frustum.
+        /// @param frustum View frustum in world space
+        /// @param visible Resized to Size(); 1 for visible items, 0 for culled ones
+        /// @return Number of visible items
+        int Cull(const Frustum &frustum, std::vector<uint8_t> &visible) const;
+
+    private:
+        /// @brief Tree node over the items _Order[First .. First+Count); leaves have Left = -1.
+        struct Node
+        {
+            AABB Bounds;
+            int Left;  ///< First child (the second is Left + 1), -1 for leaves
+            int First; ///< First item of the subtree in _Order
+            int Count; ///< Number of items in the subtree
+        };
+
+        std::vector<AABB> _Bounds; ///< World bounds per item
+        std::vector<int> _Order;   ///< Item indices ordered by leaf
+        std::vector<Node> _Nodes;  ///< Flat node array, root at index 0; children always follow their parent
+
+        bool _NeedsBuild = false; ///< Items were added since the last build
+        bool _NeedsRefit = false; ///< Bounds changed since the last refit
+
+        /// @brief Fill node 'index' with the subtree over _Order[first, first+count).
+        void _BuildNode(int index, int first, int count);
+
+        /// @brief Recompute the node boxes from the item boxes, children before parents.
+        void _Refit();
+    };
+}
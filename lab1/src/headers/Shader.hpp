@@ -39,9 +39,12 @@ namespace RA
 		/// @brief Destructor – deletes the OpenGL shader program.
 		~Shader();
 
-		/// @brief Activate (use) this shader program.
+		/// @brief Activate (use) this shader program; the first use waits for it to be compiled and linked.
 		void Use();
 
+		/// @brief Did the program link; waits for it like the first Use.
+		bool IsLinked();
+
 		/// @brief Set a boolean uniform.
 		void SetUniform(const std::string &name, bool value) const;
 
@@ -57,14 +60,17 @@ namespace RA
 		/// @brief Set a 4D vector uniform.
 		void SetUniform(const std::string &name, const glm::vec4 &vec) const;
 
+		/// @brief Set a 2D vector uniform.
+		void SetUniform(const std::string &name, const glm::vec2 &vec) const;
+
 		/// @brief Returns true if this shader includes a geometry stage.
 		bool HasGeometry() const { return _geometry; };
 
 	private:
-		/// @brief Check for shader compiler or program linking errors.
-		void _CheckCompilerErrors(unsigned int shader, std::string type);
-
 		/// @brief Tracks whether this shader includes a geometry shader.
 		bool _geometry;
+
+		/// @brief Has the program been resolved with ProgramCache::Finish.
+		bool _finished = false;
 	};
 }
\ No newline at end of file
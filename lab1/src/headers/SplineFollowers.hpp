@@ -0,0 +1,127 @@
+#pragma once
+
+// Local Headers
+#include "JobSystem.hpp"
+
+// Standard Headers
+#include <algorithm>
+#include <vector>
+
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /// @brief State of one object moving along a curve, for the previous and the current simulation step.
+    struct SplineFollower
+    {
+        int Segment = 0;         ///< Current segment
+        float T = 0.0f;          ///< Parameter inside the current segment [0,1)
+        int PreviousSegment = 0; ///< Segment at the previous step
+        float PreviousT = 0.0f;  ///< Parameter at the previous step
+        float Speed = 1.0f;      ///< Segments per second
+        float Start = 0.0f;      ///< Curve parameter (segment + t) the follower restarts from
+
+        /// @brief Curve parameter between the previous and the current step
+        /// @param alpha Interpolation factor [0,1]
+        /// @param segments Number of curve segments
+        /// @param segment Output segment index
+        /// @param t Output parameter inside the segment
+        void Interpolate(float alpha, int segments, int &segment, float &t) const
+        {
+            float previous = PreviousSegment + PreviousT;
+            float current = Segment + T;
+            if (current < previous)
+                current += segments; // the last step wrapped around to the start
+
+            float u = previous + (current - previous) * glm::clamp(alpha, 0.0f, 1.0f);
+            if (u >= segments)
+                u -= segments;
+
+            segment = std::min(static_cast<int>(u), segments - 1);
+            t = u - segment;
+        }
+    };
+
+    /**
+     * @brief Contiguous storage of spline followers, advanced in parallel batches.
+     *
+     * Followers are plain structs in one array, so any number of them can move along the
+     * same curve and a batch is a contiguous range. Update works on any curve type that
+     * provides SegmentCount and GetPoint (see CurveSampling.hpp), and only writes to the
+     * followers and positions of its own range, so batches need no locking.
+     */
+    class SplineFollowers
+    {
+    public:
+        /// @brief Followers per job in Update.
+        static constexpr size_t BATCH = 2048;
+
+        /// @brief Add a follower
+        /// @param speed Segments per second
+        /// @param start Curve parameter (segment + t) it starts from
+        /// @return Index of the follower
+        size_t Add(float speed = 1.0f, float start = 0.0f);
+
+        /// @brief Remove all followers
+        void Clear();
+
+        /// @brief Move every follower back to its start
+        void Reset();
+
+        /// @brief Number of followers
+        size_t Size() const { return _followers.size(); }
+
+        /// @brief Follower at an index
+        const SplineFollower &operator[](size_t index) const { return _followers[index]; }
+
+        /// @brief Curve positions of all followers after the last Update
+        const std::vector<glm::vec3> &Positions() const { return _positions; }
+
+        /// @brief Advance every follower by one step and evaluate its position
+        /// @param curve Curve to follow
+        /// @param delta_time Step in seconds
+        /// @param jobs Job system to spread the batches over, or nullptr to update on the calling thread
+        template <typename Curve>
+        void Update(const Curve &curve, float delta_time, JobSystem *jobs = nullptr)
+        {
+            int segments = curve.SegmentCount();
+            if (segments <= 0 || _followers.empty())
+                return;
+
+            _positions.resize(_followers.size());
+
+            auto update = [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    SplineFollower &follower = _followers[i];
+                    follower.PreviousSegment = follower.Segment;
+                    follower.PreviousT = follower.T;
+
+                    // Loop along the spline
+                    follower.T += follower.Speed * delta_time;
+                    while (follower.T >= 1.0f)
+                    {
+                        follower.T -= 1.0f;
+                        if (++follower.Segment >= segments)
+                            follower.Segment = 0;
+                    }
+                    if (follower.Segment >= segments)
+                        follower.Segment %= segments; // the curve got shorter
+
+                    _positions[i] = curve.GetPoint(follower.Segment, follower.T);
+                }
+            };
+
+            if (jobs)
+                jobs->ParallelFor(_followers.size(), BATCH, update);
+            else
+                update(0, _followers.size());
+        }
+
+    private:
+        std::vector<SplineFollower> _followers; ///< Follower states
+        std::vector<glm::vec3> _positions;      ///< Position of each follower after the last update
+    };
+}
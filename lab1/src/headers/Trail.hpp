@@ -0,0 +1,77 @@
+#pragma once
+
+// Local Headers
+#include "Renderable.hpp"
+// Standard Headers
+#include <vector>
+// External Headers
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /**
+     * @brief Fixed-capacity motion trail that fades out with age.
+     *
+     * Points live in a ring buffer: a new point overwrites the oldest one at the head index,
+     * and only the newly written slots are uploaded. The ring is drawn with the 'polyline' shader
+     * as two runs of thick segments (oldest part, then the wrapped part), so the per-frame cost
+     * does not depend on the capacity.
+     */
+    class Trail : public Renderable
+    {
+    public:
+        /// @brief Constructor
+        /// @param capacity Maximum number of points kept
+        /// @param size Line width in pixels
+        /// @param color Color of the newest point; alpha fades to zero over the lifetime
+        /// @param lifetime Age in seconds at which a point is fully transparent
+        Trail(int capacity, float size, glm::vec4 color, float lifetime = 2.0f);
+
+        /// @brief Destructor – deletes the GPU buffer.
+        ~Trail();
+
+        Trail(const Trail &) = delete;
+        Trail &operator=(const Trail &) = delete;
+
+        /// @brief Append a point, overwriting the oldest one once the trail is full
+        /// @param point World-space position
+        /// @param time Timestamp in seconds (same clock as glfwGetTime)
+        void Push(const glm::vec3 &point, float time);
+
+        /// @brief Remove all points
+        void Clear();
+
+        /// @brief Number of points currently in the trail
+        int Size() const { return _count; }
+
+        void Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat) override;
+
+    private:
+        /// @brief One trail vertex as stored on the GPU
+        struct Vertex
+        {
+            glm::vec3 Position;
+            float Time;
+        };
+
+        /// @brief Upload the slots written since the last frame
+        void _UploadPending();
+
+        /// @brief Upload ring slots [first, first + count) without wrapping
+        void _UploadRange(int first, int count);
+
+        /// @brief Draw the segments between ring slots [first, first + points) as one instanced call
+        void _DrawSegments(int first, int points);
+
+        std::vector<Vertex> _vertices; ///< Ring storage, capacity + 1 slots (the last mirrors slot 0)
+        int _capacity;                 ///< Maximum number of points
+        int _head = 0;                 ///< Slot the next point is written to
+        int _count = 0;                ///< Number of valid points
+        int _pending = 0;              ///< Points pushed since the last upload
+
+        GLuint _VBO = 0;   ///< Ring buffer on the GPU
+        float _line_size;  ///< Line width in pixels
+        glm::vec4 _color;  ///< Color of the newest point
+        float _lifetime;   ///< Fade-out time in seconds
+    };
+}
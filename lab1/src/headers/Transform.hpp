@@ -3,6 +3,7 @@
 // External headers
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace RA
 {
@@ -10,35 +11,53 @@ namespace RA
 	{
 	protected:
 		glm::vec3 _position;
-		glm::vec3 _front;
-		glm::vec3 _up;
-		glm::vec3 _right;
+		glm::quat _rotation; // Maps local +Z to front and +Y to up; right is front x up
 		glm::vec3 _scale;
 		bool _dirty;
+		int _rotationsSinceNormalize;
 
 		glm::mat4 _modelMatrix;
 
 		void _RecalculateModelMatrix();
 
+		// Incremental rotations accumulate rounding error; renormalize every few of them
+		void _Renormalize();
+
 	public:
+		// Number of incremental rotations between two renormalizations
+		static constexpr int RENORMALIZE_INTERVAL = 16;
+
 		Transform();
 
 		// Transform operations
 		void Rotate(const glm::mat4 &rotation);
+		void Rotate(const glm::quat &rotation);
 		void Rotate(float x_offset, float y_offset, bool constrain_pitch, float sensitivity);
 		void MoveG(const glm::vec3 &delta);
 		void MoveL(const glm::vec3 &delta);
 		void SetPosition(const glm::vec3 &position);
 		void SetOrientation(const glm::vec3 &front, const glm::vec3 &up);
 		void SetOrientation(const glm::vec3 &front, const glm::vec3 &up, const glm::vec3 &right);
+		void SetRotation(const glm::quat &rotation);
 		void SetScale(const glm::vec3 &scale);
 
+		// Use a matrix composed elsewhere (e.g. by a TransformHierarchy) as the model matrix;
+		// position, rotation and scale are read back from it
+		void SetWorldMatrix(const glm::mat4 &matrix);
+
 		glm::vec3 GetPosition() const { return _position; }
 		glm::vec3 GetScale() const { return _scale; }
-		glm::vec3 GetFront() const { return _front; }
-		glm::vec3 GetUp() const { return _up; }
-		glm::vec3 GetRight() const { return _right; }
+		glm::quat GetRotation() const { return _rotation; }
+		glm::vec3 GetFront() const { return _rotation * glm::vec3(0.0f, 0.0f, 1.0f); }
+		glm::vec3 GetUp() const { return _rotation * glm::vec3(0.0f, 1.0f, 0.0f); }
+		glm::vec3 GetRight() const { return _rotation * glm::vec3(-1.0f, 0.0f, 0.0f); }
 
 		glm::mat4 GetModelMatrix();
+
+		// Rotation whose front and up are the given directions (up is orthogonalized against front)
+		static glm::quat LookRotation(const glm::vec3 &front, const glm::vec3 &up);
+
+		// Normalized linear interpolation along the shorter arc; close to slerp for small steps and much cheaper
+		static glm::quat Nlerp(const glm::quat &from, const glm::quat &to, float t);
 	};
-}
\ No newline at end of file
+}
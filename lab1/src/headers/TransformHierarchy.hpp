@@ -0,0 +1,88 @@
+#pragma once
+
+// Local Headers
+#include "JobSystem.hpp"
+
+// Standard Headers
+#include <cstdint>
+#include <vector>
+
+// External Headers
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace RA
+{
+    /**
+     * @brief Data-oriented storage of many transforms with parent links.
+     *
+     * Every component lives in its own contiguous array (structure of arrays), indexed by node.
+     * A node can only be created under an existing one, so parents always come before their
+     * children and one pass in index order composes the whole tree. Nodes are also grouped by
+     * depth: all nodes of one level only read the level above, so a level can be split into
+     * parallel batches.
+     *
+     * Only nodes whose local transform changed, and their descendants, are recomposed. The local
+     * TRS matrix is written directly from the rotation, scale and position, and composing it with
+     * the parent is a single affine multiply.
+     */
+    class TransformHierarchy
+    {
+    public:
+        using Node = int;
+
+        /// @brief Parent of a root node.
+        static constexpr Node NONE = -1;
+
+        /// @brief Nodes per job when a level is updated in parallel.
+        static constexpr size_t BATCH = 1024;
+
+        /// @brief Create a node with an identity local transform
+        /// @param parent Existing parent node, or NONE for a root
+        /// @return The new node
+        Node Create(Node parent = NONE);
+
+        /// @brief Remove all nodes
+        void Clear();
+
+        /// @brief Number of nodes
+        size_t Size() const { return _parent.size(); }
+
+        /// @brief Parent of a node (NONE for a root)
+        Node GetParent(Node node) const { return _parent[node]; }
+
+        /// @brief Set the position relative to the parent
+        void SetPosition(Node node, const glm::vec3 &position);
+
+        /// @brief Set the orientation relative to the parent from a front and an up direction
+        void SetOrientation(Node node, const glm::vec3 &front, const glm::vec3 &up);
+
+        /// @brief Set the rotation relative to the parent
+        void SetRotation(Node node, const glm::quat &rotation);
+
+        /// @brief Set the scale relative to the parent
+        void SetScale(Node node, const glm::vec3 &scale);
+
+        /// @brief World matrix of a node as of the last Update
+        const glm::mat4 &GetWorldMatrix(Node node) const { return _world[node]; }
+
+        /// @brief Recompose the world matrices of changed nodes and their descendants
+        /// @param jobs Job system to split large levels over, or nullptr to update on the calling thread
+        /// @return Number of nodes that were recomposed
+        size_t Update(JobSystem *jobs = nullptr);
+
+    private:
+        /// @brief Recompose one node if it or its parent changed; returns true if it did
+        bool _UpdateNode(Node node);
+
+        std::vector<Node> _parent;              ///< Parent of each node
+        std::vector<glm::vec3> _position;       ///< Local position
+        std::vector<glm::quat> _rotation;       ///< Local rotation (same convention as Transform)
+        std::vector<glm::vec3> _scale;          ///< Local scale
+        std::vector<glm::mat4> _world;          ///< Composed local-to-world matrix
+        std::vector<uint8_t> _dirty;            ///< Local transform changed since the last update
+        std::vector<uint8_t> _changed;          ///< World matrix was recomposed in the current update
+        std::vector<int> _depth;                ///< Number of ancestors
+        std::vector<std::vector<Node>> _levels; ///< Nodes of each depth, in index order
+    };
+}
@@ -22,6 +22,9 @@ public:
 
     GLFWwindow *GetNativeHandle() const { return _Window; }
 
+    void SetTitle(const std::string &title) const;
+    void SetTitle(const char *title) const;
+
     // New: Perspective matrix from window size
     glm::mat4 GetPerspectiveMatrix(float fov = 45.f, float nearPlane = 0.1f, float farPlane = 100.f) const;
 
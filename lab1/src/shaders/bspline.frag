@@ -0,0 +1,12 @@
+#version 330 core
+
+// Uniformne varijable.
+uniform vec4 COLOR;
+
+// Izlazne varijable.
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = COLOR;
+}
@@ -0,0 +1,16 @@
+#version 330 core
+
+// Uniformne varijable.
+uniform mat4 PERS_MAT;
+uniform mat4 VIEW_MAT;
+uniform mat4 MODEL_MAT;
+
+// Ulazne varijable.
+layout(location = 0) in vec3 aPos; // Kontrolna točka.
+
+void main()
+{
+    // Kontrolne točke se odmah prebacuju u clip prostor; kubni polinom u homogenim
+    // koordinatama je točna projekcija krivulje, pa geometry shader može interpolirati tu.
+    gl_Position = PERS_MAT * VIEW_MAT * MODEL_MAT * vec4(aPos, 1.0);
+}
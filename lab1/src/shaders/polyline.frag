@@ -1,15 +1,21 @@
 #version 330 core
 
-// Uniformne varijable.
-uniform vec4 COLOR;
-
 // Ulazne varijable.
-in vec3 FragPos;
+flat in vec4 LineColor;
+flat in float HalfWidth;
+flat in float SegmentLength;
+noperspective in vec2 Local;
+noperspective in float Fade;
 
 // Izlazne varijable.
 out vec4 FragColor;
 
 void main()
-{    
-    FragColor = COLOR;
+{
+    // Udaljenost od segmenta; sve izvan kapsule se odbacuje, što daje zaobljene krajeve i spojeve.
+    float x = clamp(Local.x, 0.0, SegmentLength);
+    if (length(vec2(Local.x - x, Local.y)) > HalfWidth)
+        discard;
+
+    FragColor = vec4(LineColor.rgb, LineColor.a * Fade);
 }
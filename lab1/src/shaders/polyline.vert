@@ -4,15 +4,91 @@
 uniform mat4 PERS_MAT;
 uniform mat4 VIEW_MAT;
 uniform mat4 MODEL_MAT;
+uniform vec4 COLOR;
+uniform float WIDTH;          // Debljina linije u pikselima.
+uniform vec2 VIEWPORT;        // Veličina prozora u pikselima.
+uniform bool USE_LINE_BUFFER; // Atributi linije se čitaju iz LINES umjesto iz uniformi.
+uniform samplerBuffer LINES;  // Po liniji 6 texela: 4 stupca matrice modela, boja, debljina.
+uniform bool FADE;            // Trag: prozirnost raste sa starošću točaka, segmenti nemaju zaobljene krajeve.
+uniform float NOW;            // Trenutno vrijeme u sekundama.
+uniform float LIFETIME;       // Vrijeme nakon kojeg je točka potpuno prozirna.
 
-// Ulazne varijable.
-layout(location = 0) in vec3 aPos;
+// Ulazne varijable (po instanci; jedna instanca je jedan segment linije).
+layout(location = 0) in vec3 aP0;
+layout(location = 1) in vec3 aP1;
+layout(location = 2) in float aTime0; // Vrijeme kada je dodana točka aP0 (samo uz FADE).
+layout(location = 3) in float aTime1; // Vrijeme kada je dodana točka aP1 (samo uz FADE).
+layout(location = 4) in float aLine0; // Indeks linije točke aP0 u LINES, -1 za prazno mjesto (samo uz USE_LINE_BUFFER).
+layout(location = 5) in float aLine1; // Indeks linije točke aP1 u LINES, -1 za prazno mjesto (samo uz USE_LINE_BUFFER).
 
 // Izlazne varijable.
-out vec3 FragPos;
+flat out vec4 LineColor;
+flat out float HalfWidth;
+flat out float SegmentLength;
+noperspective out vec2 Local; // Položaj u pikselima, u koordinatnom sustavu segmenta.
+noperspective out float Fade;
 
 void main()
 {
-    gl_Position = PERS_MAT * VIEW_MAT * MODEL_MAT * vec4(aPos, 1.0);
-    FragPos = aPos;
-}
\ No newline at end of file
+    mat4 model = MODEL_MAT;
+    vec4 color = COLOR;
+    float width = WIDTH;
+
+    if (USE_LINE_BUFFER)
+    {
+        // Segment između dvije linije ili na praznom mjestu se ne crta.
+        if (aLine0 < 0.0 || aLine0 != aLine1)
+        {
+            gl_Position = vec4(0.0);
+            return;
+        }
+
+        int base = int(aLine0 + 0.5) * 6;
+        model = mat4(texelFetch(LINES, base), texelFetch(LINES, base + 1), texelFetch(LINES, base + 2), texelFetch(LINES, base + 3));
+        color = texelFetch(LINES, base + 4);
+        width = texelFetch(LINES, base + 5).x;
+    }
+
+    mat4 mvp = PERS_MAT * VIEW_MAT * model;
+    vec4 c0 = mvp * vec4(aP0, 1.0);
+    vec4 c1 = mvp * vec4(aP1, 1.0);
+
+    // Segment se odsijeca ispred kamere, da dijeljenje s w ostane valjano.
+    const float NEAR_W = 1e-4;
+    if (c0.w < NEAR_W && c1.w < NEAR_W)
+    {
+        gl_Position = vec4(0.0);
+        return;
+    }
+    if (c0.w < NEAR_W)
+        c0 = mix(c0, c1, (NEAR_W - c0.w) / (c1.w - c0.w));
+    else if (c1.w < NEAR_W)
+        c1 = mix(c1, c0, (NEAR_W - c1.w) / (c0.w - c1.w));
+
+    vec2 half_viewport = 0.5 * VIEWPORT;
+    vec2 s0 = c0.xy / c0.w * half_viewport;
+    vec2 s1 = c1.xy / c1.w * half_viewport;
+
+    vec2 axis = s1 - s0;
+    float len = length(axis);
+    vec2 dir = len > 1e-6 ? axis / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-dir.y, dir.x);
+
+    // Vrhovi pravokutnika za triangle strip: (početak, +), (početak, -), (kraj, +), (kraj, -).
+    // Pravokutnik je produljen za pola debljine na oba kraja zbog zaobljenih krajeva i spojeva.
+    // Prozirni trag se ne produljuje: krajevi susjednih segmenata bi se preklapali i miješali dvaput.
+    bool at_end = gl_VertexID >= 2;
+    float side = (gl_VertexID & 1) == 0 ? 1.0 : -1.0;
+    float extent = 0.5 * width + 1.0;
+    float cap = FADE ? 0.0 : extent;
+
+    vec4 c = at_end ? c1 : c0;
+    vec2 s = (at_end ? s1 : s0) + dir * (at_end ? cap : -cap) + normal * side * extent;
+    gl_Position = vec4(s / half_viewport * c.w, c.z, c.w);
+
+    LineColor = color;
+    HalfWidth = 0.5 * width;
+    SegmentLength = len;
+    Local = vec2(dot(s - s0, dir), dot(s - s0, normal));
+    Fade = FADE ? clamp(1.0 - (NOW - (at_end ? aTime1 : aTime0)) / LIFETIME, 0.0, 1.0) : 1.0;
+}
@@ -1,8 +1,13 @@
 #include "Application.hpp"
+#include "Frustum.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
+#include <cstdio>
 
 namespace RA
 {
     std::shared_ptr<Application> Application::Instance = nullptr;
+    std::string Application::TraceFile;
 
     Application::Application()
     {
@@ -10,25 +15,52 @@ namespace RA
     }
 
     void Application::Run()
+    {
+        Open();
+
+        if (!TraceFile.empty())
+            Profiler::Enable();
+
+        // Start Application Loop
+        _Loop();
+
+        GLState::PrintStats();
+
+        if (Profiler::IsEnabled())
+        {
+            Profiler::ExportChromeTrace(TraceFile);
+            Profiler::Shutdown();
+        }
+    }
+
+    void Application::Open()
     {
         // Open Window
-        _Window = std::make_unique<Window>(1000, 800, "Računalna Animacija - Laboratorijska Vježba 1");
+        _Title = "Računalna Animacija - Laboratorijska Vježba 1";
+        _Window = std::make_unique<Window>(1000, 800, _Title);
 
         // Setup of Rendering
         _Renderer = std::make_unique<Renderer>();
         _Renderer->SetWireframe(true);
+        _Queue = std::make_unique<RenderQueue>();
+        _Jobs = std::make_unique<JobSystem>();
+        _Followers.Add();
+        _ObjectNode = _Scene.Create();
+        _TangentNode = _Scene.Create(_ObjectNode);
 
         // Load Assets
         _Assets = Assets();
         _Assets.LoadAssets();
 
-        // Start Application Loop
-        _Loop();
+        // The trail is cheap and always on screen around the object, so it is not culled
+        _CullObject = _Culling.Add(_Assets.ObjectMesh->GetWorldBounds());
+        _CullCurve = _Culling.Add(_Assets.BSplineCurve->GetBounds());
+        _CullTangent = _Culling.Add(_Assets.ObjectTangent->GetWorldBounds());
     }
 
     void Application::_Loop()
     {
-        float lastFrame = 0.0f;
+        float lastFrame = static_cast<float>(glfwGetTime());
 
         while (!_Window->ShouldClose())
         {
@@ -36,19 +68,146 @@ namespace RA
             float deltaTime = currentFrame - lastFrame;
             lastFrame = currentFrame;
 
-            // Input
+            Frame(deltaTime, Input::IsFollowKeyPressed(_Window->GetNativeHandle()));
+        }
+    }
+
+    void Application::Frame(float deltaTime, bool follow_key)
+    {
+        Profiler::BeginFrame();
+
+        // Input
+        {
+            RA_PROFILE_SCOPE("Input");
             Input::ProcessCameraInput(_Window->GetNativeHandle(), deltaTime, _Camera);
-            Input::ProcessBSplineFollow(_Window->GetNativeHandle(), deltaTime, _Assets.ObjectMesh, _Assets.ObjectTangent, _Assets.BSplineCurve);
 
-            // Render
+            // The key switches the curve between the geometry shader and the adaptive CPU sampler
+            bool tessellation_key = Input::IsTessellationKeyPressed(_Window->GetNativeHandle());
+            if (tessellation_key && !_TessellationKey)
+            {
+                if (_Assets.BSplineCurve->IsTessellatedOnGpu())
+                    _Assets.BSplineCurve->SetTessellationShader(nullptr);
+                else if (_Assets.BSplineShader->IsLinked())
+                    _Assets.BSplineCurve->SetTessellationShader(_Assets.BSplineShader);
+            }
+            _TessellationKey = tessellation_key;
+        }
+
+        // Stage 1: a worker simulates the next frame into the back snapshot
+        FrameSnapshot &next = _Snapshots[1 - _Front];
+        JobSystem::Handle simulation = _Jobs->Submit([this, &next, follow_key, deltaTime]()
+                                                     { _Simulate(next, follow_key, deltaTime); });
+
+        // Stage 2: this thread renders the front snapshot, simulated during the previous frame
+        const FrameSnapshot &frame = _Snapshots[_Front];
+        {
+            RA_PROFILE_SCOPE("Apply snapshot");
+            float now = static_cast<float>(glfwGetTime());
+            for (const glm::vec3 &point : frame.TrailPoints)
+                _Assets.ObjectTrail->Push(point, now);
+
+            if (frame.Following)
+                Input::ApplyBSplineFollow(frame.Follow, frame.Alpha, _Scene, _ObjectNode, _Assets.BSplineCurve);
+
+            // The tangent gizmo is attached to the object node and moves with it
+            if (_Scene.Update(_Jobs.get()) > 0)
+            {
+                _Assets.ObjectMesh->SetWorldMatrix(_Scene.GetWorldMatrix(_ObjectNode));
+                _Assets.ObjectTangent->SetWorldMatrix(_Scene.GetWorldMatrix(_TangentNode));
+
+                _Culling.SetBounds(_CullObject, _Assets.ObjectMesh->GetWorldBounds());
+                _Culling.SetBounds(_CullTangent, _Assets.ObjectTangent->GetWorldBounds());
+            }
+        }
+
+        glm::mat4 view = _Camera.GetViewMatrix();
+        glm::mat4 projection = _Window->GetPerspectiveMatrix();
+
+        // The CPU curve keeps a tolerance in pixels, so it is sampled again when the camera moves
+        if (!_Assets.BSplineCurve->IsTessellatedOnGpu() && projection * view != _CurveView)
+        {
+            RA_PROFILE_SCOPE("Curve sampling");
+            int width, height;
+            glfwGetFramebufferSize(_Window->GetNativeHandle(), &width, &height);
+            _CurveView = projection * view;
+            _Assets.BSplineCurve->RebuildForView(_CurveView, glm::vec2(width, height));
+        }
+
+        {
+            RA_PROFILE_SCOPE("Culling");
+            _Culling.Update();
+            _VisibleCount = _Culling.Cull(Frustum(projection * view), _Visible);
+        }
+
+        // Render
+        {
+            RA_PROFILE_GPU("Render");
             _Renderer->Clear();
 
-            _Assets.ObjectMesh->Render(_Assets.ObjectShader, _Camera.GetViewMatrix(), _Window->GetPerspectiveMatrix());
-            _Assets.BSplineCurve->Render(_Assets.PolylineShader, _Camera.GetViewMatrix(), _Window->GetPerspectiveMatrix());
-            _Assets.ObjectTangent->Render(_Assets.PolylineShader, _Camera.GetViewMatrix(), _Window->GetPerspectiveMatrix());
+            if (_Visible[_CullObject])
+                _Assets.ObjectMesh->Submit(*_Queue, _Assets.ObjectShader);
+            if (_Visible[_CullCurve])
+                _Assets.BSplineCurve->Submit(*_Queue, _Assets.PolylineShader);
+            if (_Visible[_CullTangent])
+                _Assets.ObjectTangent->Submit(*_Queue, _Assets.PolylineShader);
+            _Assets.ObjectTrail->Submit(*_Queue, _Assets.PolylineShader);
 
+            _Queue->Flush(view, projection);
+        }
+        _UpdateStatsOverlay(deltaTime);
+
+        {
+            RA_PROFILE_SCOPE("Swap buffers");
             _Window->SwapBuffers();
             _Window->PollEvents();
         }
+
+        {
+            RA_PROFILE_SCOPE("Wait for simulation");
+            _Jobs->Wait(simulation);
+            _Front = 1 - _Front;
+        }
+
+        Profiler::EndFrame();
+    }
+
+    void Application::_Simulate(FrameSnapshot &out, bool follow_key, float delta_time)
+    {
+        RA_PROFILE_SCOPE("Simulation");
+
+        out.TrailPoints.clear();
+
+        // Fixed steps; the snapshot keeps the last two so rendering can interpolate
+        Input::ProcessFollowToggle(follow_key, _Followers);
+
+        int steps = _Timestep.Advance(delta_time);
+        float step = static_cast<float>(_Timestep.Step());
+        for (int i = 0; i < steps; i++)
+            Input::ProcessBSplineFollow(step, _Assets.BSplineCurve, _Followers, _Jobs.get(), &out.TrailPoints);
+
+        out.Following = Input::IsFollowing();
+        out.Follow = _Followers[0];
+        out.Alpha = _Timestep.Alpha();
+    }
+
+    void Application::_UpdateStatsOverlay(float delta_time)
+    {
+        _StatsTimer += delta_time;
+        _StatsFrames++;
+
+        if (_StatsTimer < 0.5f)
+            return;
+
+        const RenderStats &stats = _Queue->GetStats();
+        int fps = static_cast<int>(_StatsFrames / _StatsTimer + 0.5f);
+
+        // Formatted into a fixed buffer, since this runs in the frame loop
+        std::snprintf(_TitleText, sizeof(_TitleText), "%s | %d FPS | draws %d/%d packets | programs %d | VAOs %d | merged lines %d | visible %d/%d",
+                      _Title.c_str(), fps, stats.DrawCalls, stats.Packets, stats.ProgramChanges, stats.VAOChanges, stats.MergedLines,
+                      _VisibleCount, _Culling.Size());
+        _Window->SetTitle(_TitleText);
+
+        _StatsTimer = 0.0f;
+        _StatsFrames = 0;
     }
 }
\ No newline at end of file
@@ -1,50 +1,344 @@
+// Local Headers
 #include "Assets.hpp"
+#include "MappedFile.hpp"
+#include "ProgramCache.hpp"
+// Standard Headers
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 
 namespace RA
 {
+    namespace
+    {
+        /// Header of a .crvb file (see Assets.hpp for the layout).
+        struct CRVBHeader
+        {
+            char Magic[4];
+            uint32_t Version;
+            uint32_t Flags;
+            uint32_t Reserved;
+            uint64_t Count;
+        };
+
+        static_assert(sizeof(CRVBHeader) == 24, "CRVB header must stay 24 bytes.");
+        static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "CRVB points are stored as packed float3.");
+
+        constexpr uint32_t CRVB_VERSION = 1;
+        constexpr uint32_t CRVB_FLAG_TIMES = 1;
+
+        bool IsBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == ',';
+        }
+
+        /// Parses whitespace separated numbers from [begin, end); returns how many were read (at most 4).
+        int ParseLine(const char *begin, const char *end, float *values)
+        {
+            int count = 0;
+            const char *p = begin;
+            while (count < 4)
+            {
+                while (p < end && IsBlank(*p))
+                    p++;
+                if (p < end && *p == '+')
+                    p++;
+                if (p >= end)
+                    break;
+
+                auto result = std::from_chars(p, end, values[count]);
+                if (result.ec != std::errc())
+                    break;
+
+                p = result.ptr;
+                count++;
+            }
+            return count;
+        }
+
+        /// Stream-based parser kept as the baseline for BenchmarkCRV.
+        std::vector<glm::vec3> LoadCRVStream(const std::string &filename)
+        {
+            std::vector<glm::vec3> points;
+            std::ifstream file(filename);
+
+            std::string line;
+            while (std::getline(file, line))
+            {
+                if (line.empty())
+                    continue;
+
+                std::istringstream iss(line);
+                float x, y, z;
+                if (iss >> x >> y >> z)
+                    points.emplace_back(x, y, z);
+            }
+
+            return points;
+        }
+
+        bool EndsWith(const std::string &value, const std::string &suffix)
+        {
+            return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+    }
+
     std::vector<glm::vec3> Assets::LoadCRV(std::string filename)
     {
         std::vector<glm::vec3> points;
-        std::ifstream file(filename);
+        LoadCRV(filename, points, nullptr);
+        return points;
+    }
 
-        if (!file.is_open())
+    bool Assets::LoadCRV(const std::string &filename, std::vector<glm::vec3> &points, std::vector<float> *times)
+    {
+        points.clear();
+        if (times)
+            times->clear();
+
+        MappedFile file(filename);
+
+        if (!file.IsOpen())
         {
             std::cerr << "[ERROR] Failed to open curve file: " << filename << std::endl;
-            return points;
+            return false;
         }
 
-        std::string line;
-        while (std::getline(file, line))
+        const char *data = file.Data();
+        const char *end = data + file.Size();
+
+        // Pre-pass: one point per line at most, so a single reservation covers the file.
+        size_t lines = static_cast<size_t>(std::count(data, end, '\n')) + 1;
+        points.reserve(lines);
+        if (times)
+            times->reserve(lines);
+
+        bool all_times = true;
+        size_t invalid_lines = 0;
+        size_t first_invalid = 0;
+        size_t line_number = 0;
+
+        const char *p = data;
+        while (p < end)
         {
-            if (line.empty())
-                continue;
+            const char *eol = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!eol)
+                eol = end;
+            line_number++;
 
-            std::istringstream iss(line);
-            float x, y, z;
-            if (iss >> x >> y >> z)
-            {
-                points.emplace_back(x, y, z);
-            }
-            else
+            const char *q = p;
+            while (q < eol && IsBlank(*q))
+                q++;
+
+            if (q < eol)
             {
-                std::cerr << "[WARNING] Invalid line in curve file: " << line << std::endl;
+                float values[4];
+                int count = ParseLine(q, eol, values);
+                if (count >= 3)
+                {
+                    points.emplace_back(values[0], values[1], values[2]);
+                    if (times)
+                    {
+                        all_times = all_times && count == 4;
+                        times->push_back(count == 4 ? values[3] : 0.0f);
+                    }
+                }
+                else if (invalid_lines++ == 0)
+                {
+                    first_invalid = line_number;
+                }
             }
+
+            p = eol + 1;
+        }
+
+        // Per-line logging dominates on large files, so invalid lines are reported once.
+        if (invalid_lines > 0)
+            std::cerr << "[WARNING] " << invalid_lines << " invalid line(s) in curve file " << filename << ", first at line " << first_invalid << std::endl;
+
+        if (times && !all_times)
+            times->clear();
+
+        return true;
+    }
+
+    bool Assets::LoadCRVB(const std::string &filename, std::vector<glm::vec3> &points, std::vector<float> *times)
+    {
+        points.clear();
+        if (times)
+            times->clear();
+
+        MappedFile file(filename);
+
+        if (!file.IsOpen())
+        {
+            std::cerr << "[ERROR] Failed to open curve file: " << filename << std::endl;
+            return false;
+        }
+
+        CRVBHeader header;
+        if (file.Size() < sizeof(header))
+        {
+            std::cerr << "[ERROR] Curve file is too small to be a .crvb file: " << filename << std::endl;
+            return false;
         }
+        std::memcpy(&header, file.Data(), sizeof(header));
+
+        if (std::memcmp(header.Magic, "CRVB", 4) != 0 || header.Version != CRVB_VERSION)
+        {
+            std::cerr << "[ERROR] Unsupported .crvb header in: " << filename << std::endl;
+            return false;
+        }
+
+        bool has_times = (header.Flags & CRVB_FLAG_TIMES) != 0;
+
+        // The count comes from the file; bound it by the payload size before any arithmetic can wrap.
+        uint64_t record_bytes = sizeof(glm::vec3) + (has_times ? sizeof(float) : 0);
+        if (header.Count > (file.Size() - sizeof(header)) / record_bytes)
+        {
+            std::cerr << "[ERROR] Truncated .crvb file: " << filename << std::endl;
+            return false;
+        }
+
+        uint64_t point_bytes = header.Count * sizeof(glm::vec3);
+        uint64_t time_bytes = has_times ? header.Count * sizeof(float) : 0;
+
+        // The payload is already in memory layout; one bulk copy from the mapping, no parsing.
+        const char *payload = file.Data() + sizeof(header);
+        points.resize(static_cast<size_t>(header.Count));
+        std::memcpy(points.data(), payload, static_cast<size_t>(point_bytes));
+
+        if (times && has_times)
+        {
+            times->resize(static_cast<size_t>(header.Count));
+            std::memcpy(times->data(), payload + point_bytes, static_cast<size_t>(time_bytes));
+        }
+
+        return true;
+    }
+
+    bool Assets::SaveCRVB(const std::string &filename, const std::vector<glm::vec3> &points, const std::vector<float> *times)
+    {
+        bool has_times = times && times->size() == points.size() && !points.empty();
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "[ERROR] Failed to create curve file: " << filename << std::endl;
+            return false;
+        }
+
+        CRVBHeader header;
+        std::memcpy(header.Magic, "CRVB", 4);
+        header.Version = CRVB_VERSION;
+        header.Flags = has_times ? CRVB_FLAG_TIMES : 0;
+        header.Reserved = 0;
+        header.Count = points.size();
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(points.data()), static_cast<std::streamsize>(points.size() * sizeof(glm::vec3)));
+        if (has_times)
+            file.write(reinterpret_cast<const char *>(times->data()), static_cast<std::streamsize>(times->size() * sizeof(float)));
+
+        return static_cast<bool>(file);
+    }
+
+    std::vector<glm::vec3> Assets::LoadCurve(const std::string &filename)
+    {
+        std::vector<glm::vec3> points;
+
+        if (EndsWith(filename, ".crvb"))
+            LoadCRVB(filename, points);
+        else
+            LoadCRV(filename, points, nullptr);
 
-        file.close();
         return points;
     }
+
+    bool Assets::ConvertCRV(const std::string &input, const std::string &output)
+    {
+        std::vector<glm::vec3> points;
+        std::vector<float> times;
+
+        if (!LoadCRV(input, points, &times))
+            return false;
+
+        if (!SaveCRVB(output, points, &times))
+            return false;
+
+        std::cout << "[DEBUG]: Converted " << points.size() << " points" << (times.empty() ? "" : " with times") << " from " << input << " to " << output << std::endl;
+        return true;
+    }
+
+    void Assets::BenchmarkCRV(const std::string &filename, int iterations)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::string binary = filename + ".bench.crvb";
+        std::vector<glm::vec3> reference = LoadCRV(filename);
+        if (reference.empty() || !SaveCRVB(binary, reference))
+        {
+            std::cerr << "[ERROR] Nothing to benchmark in: " << filename << std::endl;
+            return;
+        }
+
+        size_t text_bytes = MappedFile(filename).Size();
+        size_t binary_bytes = MappedFile(binary).Size();
+        iterations = std::max(1, iterations);
+
+        auto report = [&](const char *name, size_t bytes, auto &&load)
+        {
+            double best = 1e30;
+            size_t count = 0;
+            for (int i = 0; i < iterations; i++)
+            {
+                auto start = Clock::now();
+                count = load().size();
+                best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+            }
+
+            std::cout << "[BENCH]: " << name << ": " << count << " points, " << best * 1000.0 << " ms, "
+                      << bytes / best / (1024.0 * 1024.0) << " MB/s, " << count / best / 1e6 << " Mpoints/s" << std::endl;
+        };
+
+        report("istringstream .crv", text_bytes, [&]()
+               { return LoadCRVStream(filename); });
+        report("from_chars .crv   ", text_bytes, [&]()
+               { return LoadCRV(filename); });
+        report("binary .crvb      ", binary_bytes, [&]()
+               { std::vector<glm::vec3> points; LoadCRVB(binary, points); return points; });
+
+        std::remove(binary.c_str());
+    }
+
     void Assets::LoadAssets()
     {
+        // Submitted first, so the driver compiles them while the mesh and the curve load.
         ObjectShader = Shader::LoadShader("object");
         PolylineShader = Shader::LoadShader("polyline");
+        BSplineShader = Shader::LoadShader("bspline");
 
         ObjectMesh = Mesh::LoadMesh(MeshFile);
         BSplineCurve = std::make_shared<BSpline>();
-        BSplineCurve->SetControlPoints(LoadCRV(CurveFile));
+        BSplineCurve->SetTessellationShader(BSplineShader);
+        BSplineCurve->SetControlPoints(LoadCurve(CurveFile));
 
         ObjectTangent = std::make_shared<Polyline>(5.0f, glm::vec4(0.7f, 0.4f, 0.11f, 1.f));
         ObjectTangent->AddPoint(glm::vec3(0.f, 0.f, 0.f));
         ObjectTangent->AddPoint(glm::vec3(0.f, 0.f, 1.f));
+
+        ObjectTrail = std::make_shared<Trail>(512, 2.0f, glm::vec4(1.f, 0.8f, 0.2f, 1.f));
+
+        ProgramCache::FinishAll();
+
+        // Without a working geometry stage the curve is drawn from the adaptive CPU sampling
+        if (!BSplineShader->IsLinked())
+        {
+            std::cout << "[WARNING]: The 'bspline' shader did not link, the curve is tessellated on the CPU" << std::endl;
+            BSplineCurve->SetTessellationShader(nullptr);
+        }
     }
-}
\ No newline at end of file
+}
@@ -1,47 +1,171 @@
 #include "BSpline.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
 
 namespace RA
 {
+    namespace
+    {
+        // Uniform cubic B-spline basis matrix, shared by the point and derivative evaluations.
+        // Different order than in .pdf
+        const glm::mat4 M(
+            -1, 3, -3, 1, // column 0
+            3, -6, 0, 4,  // column 1
+            -3, 3, 3, 1,  // column 2
+            1, 0, 0, 0    // column 3
+        );
+
+        /// Width of the curve in pixels, on both the CPU and the GPU path.
+        constexpr float CURVE_WIDTH = 2.5f;
+    }
+
     BSpline::BSpline(float step)
         : _ControlPolygon(1.5f, glm::vec4(1, 0, 0, 1)),
-          _CurveApproximation(2.5f, glm::vec4(0, 1, 0, 1)),
+          _CurveApproximation(CURVE_WIDTH, glm::vec4(0, 1, 0, 1)),
           _Step(step)
     {
     }
 
+    BSpline::~BSpline()
+    {
+        if (_TessellationVBO)
+            GLState::DeleteBuffer(_TessellationVBO);
+        if (_TessellationVAO)
+            GLState::DeleteVertexArray(_TessellationVAO);
+    }
+
     void BSpline::SetControlPoints(const std::vector<glm::vec3> &points)
     {
         _ControlPoints = points;
         _ControlPolygon.SetPoints(points);
         _BuildCurveApproximation();
+
+        // Convex hull property: the curve and the control polygon lie inside the box of the control points
+        _Bounds = AABB();
+        for (const glm::vec3 &point : _ControlPoints)
+            _Bounds.Expand(point);
+    }
+
+    void BSpline::SetControlPoints(std::vector<glm::vec3> &&points)
+    {
+        _ControlPoints = std::move(points);
+        _ControlPolygon.SetPoints(_ControlPoints);
+        _BuildCurveApproximation();
+
+        // Convex hull property: the curve and the control polygon lie inside the box of the control points
+        _Bounds = AABB();
+        for (const glm::vec3 &point : _ControlPoints)
+            _Bounds.Expand(point);
+    }
+
+    int BSpline::SegmentCount() const
+    {
+        return _ControlPoints.size() < 4 ? 0 : static_cast<int>(_ControlPoints.size()) - 3;
+    }
+
+    const ArcLengthTable &BSpline::GetArcLength() const
+    {
+        if (_ArcLengthDirty)
+        {
+            _ArcLength.Build(*this);
+            _ArcLengthDirty = false;
+        }
+        return _ArcLength;
     }
 
-    std::vector<glm::vec3> BSpline::GetControlPoints()
+    const CurveBVH &BSpline::GetSpatialIndex() const
     {
-        return _ControlPoints;
+        if (_SpatialIndexDirty)
+        {
+            _SpatialIndex.Build(_ControlPoints);
+            _SpatialIndexDirty = false;
+        }
+        return _SpatialIndex;
     }
 
     void BSpline::_BuildCurveApproximation()
     {
-        std::vector<glm::vec3> curve_points;
+        // The query structures are rebuilt on first use, so an edit on the GPU path only uploads the control points
+        _ArcLengthDirty = true;
+        _SpatialIndexDirty = true;
+        _TessellationDirty = true;
 
-        // We need at least 4 points for cubic B-spline
-        if (_ControlPoints.size() < 4)
+        // The GPU path generates the curve from the control points alone
+        if (_TessellationShader)
             return;
 
-        // For each segment of 4 control points
-        for (size_t i = 0; i + 3 < _ControlPoints.size(); i++)
+        // Sample every segment into the reused buffer, in pixels once a view is known
+        if (_Adaptive && _HasView)
         {
-            // Sample along the segment from t=0 to t=1
-            for (float t = 0.0f; t <= 1.0f; t += _Step)
-            {
-                glm::vec3 pt = GetPoint(static_cast<int>(i), t);
-                curve_points.push_back(pt);
-            }
+            TessellationTolerance tolerance = _AdaptiveTolerance;
+            tolerance.Chord = _ViewTolerance;
+            SampleCurveAdaptive(*this, tolerance, _CurvePoints, &_ViewProjection, _Viewport);
         }
+        else if (_Adaptive)
+            SampleCurveAdaptive(*this, _AdaptiveTolerance, _CurvePoints);
+        else
+            SampleCurve(*this, _Step, _CurvePoints);
 
         // Set only the curve points, do not touch control polygon
-        _CurveApproximation.SetPoints(curve_points);
+        _CurveApproximation.SetPoints(_CurvePoints);
+    }
+
+    void BSpline::SetAdaptiveTessellation(bool enabled, const TessellationTolerance &tolerance)
+    {
+        _Adaptive = enabled;
+        _AdaptiveTolerance = tolerance;
+
+        if (!_TessellationShader)
+            _BuildCurveApproximation();
+    }
+
+    void BSpline::RebuildForView(const glm::mat4 &view_projection, glm::vec2 viewport, float pixels)
+    {
+        _HasView = true;
+        _ViewProjection = view_projection;
+        _Viewport = viewport;
+        _ViewTolerance = pixels;
+
+        // The GPU path already measures its error in screen space
+        if (_TessellationShader || !_Adaptive)
+            return;
+
+        TessellationTolerance tolerance = _AdaptiveTolerance;
+        tolerance.Chord = pixels;
+
+        SampleCurveAdaptive(*this, tolerance, _CurvePoints, &view_projection, viewport);
+        _CurveApproximation.SetPoints(_CurvePoints);
+    }
+
+    void BSpline::SetTessellationShader(std::shared_ptr<Shader> shader)
+    {
+        bool was_gpu = _TessellationShader != nullptr;
+        _TessellationShader = shader;
+
+        // Switching back to the CPU path needs a fresh CPU sampling
+        if (was_gpu && !shader)
+            _BuildCurveApproximation();
+    }
+
+    void BSpline::_UploadControlPoints()
+    {
+        if (_TessellationVAO == 0)
+        {
+            glGenVertexArrays(1, &_TessellationVAO);
+            glGenBuffers(1, &_TessellationVBO);
+        }
+
+        GLState::BindVertexArray(_TessellationVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _TessellationVBO);
+        glBufferData(GL_ARRAY_BUFFER, _ControlPoints.size() * sizeof(glm::vec3), _ControlPoints.data(), GL_DYNAMIC_DRAW);
+
+        // Vertex attribute for the control point (layout location 0)
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
+        glEnableVertexAttribArray(0);
+
+        GLState::BindVertexArray(0);
+
+        _TessellationDirty = false;
     }
 
     glm::vec3 BSpline::GetPoint(int i, float t) const
@@ -49,14 +173,6 @@ namespace RA
         if (i + 3 >= (int)_ControlPoints.size())
             return glm::vec3(0);
 
-        // Different order than in .pdf
-        glm::mat4 M(
-            -1, 3, -3, 1, // column 0
-            3, -6, 0, 4,  // column 1
-            -3, 3, 3, 1,  // column 2
-            1, 0, 0, 0    // column 3
-        );
-
         glm::vec4 T(t * t * t, t * t, t, 1.0f);
 
         // Compute coefficients
@@ -77,14 +193,6 @@ namespace RA
         if (i + 3 >= (int)_ControlPoints.size())
             return glm::vec3(0);
 
-        // Same B-spline basis matrix as GetPoint()
-        glm::mat4 M(
-            -1, 3, -3, 1, // column 0
-            3, -6, 0, 4,  // column 1
-            -3, 3, 3, 1,  // column 2
-            1, 0, 0, 0    // column 3
-        );
-
         // Derivative of T: [3 t^2, 2 t, 1, 0]
         glm::vec4 Tprime(3 * t * t, 2 * t, 1.0f, 0.0f);
 
@@ -106,14 +214,6 @@ namespace RA
         if (i + 3 >= (int)_ControlPoints.size())
             return glm::vec3(0);
 
-        // Same B-spline basis matrix as GetPoint()
-        glm::mat4 M(
-            -1, 3, -3, 1, // column 0
-            3, -6, 0, 4,  // column 1
-            -3, 3, 3, 1,  // column 2
-            1, 0, 0, 0    // column 3
-        );
-
         glm::vec3 tangent = GetTangent(i, t);
 
         // Second derivative coefficients [6t, 2, 0, 0]
@@ -140,6 +240,57 @@ namespace RA
     void BSpline::Render(std::shared_ptr<Shader> shader, glm::mat4 view, glm::mat4 proj)
     {
         _ControlPolygon.Render(shader, view, proj);
-        _CurveApproximation.Render(shader, view, proj);
+
+        if (_TessellationShader)
+            _RenderTessellated(view, proj);
+        else
+            _CurveApproximation.Render(shader, view, proj);
+    }
+
+    void BSpline::Submit(RenderQueue &queue, std::shared_ptr<Shader> shader)
+    {
+        _ControlPolygon.Submit(queue, shader);
+
+        if (!_TessellationShader)
+        {
+            _CurveApproximation.Submit(queue, shader);
+            return;
+        }
+
+        queue.SubmitCustom([this](const glm::mat4 &view, const glm::mat4 &proj)
+                           { _RenderTessellated(view, proj); });
+    }
+
+    void BSpline::_RenderTessellated(const glm::mat4 &view, const glm::mat4 &proj)
+    {
+        if (SegmentCount() == 0)
+            return;
+
+        RA_PROFILE_GPU("Spline draw");
+
+        if (_TessellationDirty)
+            _UploadControlPoints();
+
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        _TessellationShader->Use();
+        _TessellationShader->SetUniform("COLOR", glm::vec4(0, 1, 0, 1));
+        _TessellationShader->SetUniform("MODEL_MAT", glm::mat4(1.0f));
+        _TessellationShader->SetUniform("VIEW_MAT", view);
+        _TessellationShader->SetUniform("PERS_MAT", proj);
+        _TessellationShader->SetUniform("VIEWPORT", glm::vec2(viewport[2], viewport[3]));
+        _TessellationShader->SetUniform("TOLERANCE", _Tolerance);
+        _TessellationShader->SetUniform("WIDTH", CURVE_WIDTH);
+
+        // The curve is emitted as a screen-space triangle strip, so it must be filled even in wireframe mode
+        GLenum polygon_mode = GLState::GetPolygonMode();
+        GLState::PolygonMode(GL_FILL);
+
+        // Every 4 consecutive control points form one lines_adjacency primitive, i.e. one segment
+        GLState::BindVertexArray(_TessellationVAO);
+        glDrawArrays(GL_LINE_STRIP_ADJACENCY, 0, static_cast<GLsizei>(_ControlPoints.size()));
+
+        GLState::PolygonMode(polygon_mode);
     }
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+// Local Headers
+#include "Benchmarks.hpp"
+#include "Assets.hpp"
+#include "BSplineT.hpp"
+#include "Frustum.hpp"
+#include "JobSystem.hpp"
+#include "SceneBVH.hpp"
+#include "SplineFollowers.hpp"
+#include "TransformHierarchy.hpp"
+// Standard Headers
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace RA
+{
+    namespace
+    {
+        /// Optional numeric argument of a benchmark, or the default if it is missing.
+        size_t Argument(const std::vector<std::string> &args, size_t index, size_t fallback)
+        {
+            return index < args.size() ? std::strtoull(args[index].c_str(), nullptr, 10) : fallback;
+        }
+
+        /// A benchmark selectable from the command line.
+        struct Entry
+        {
+            const char *Flag;  ///< Command-line flag
+            const char *Usage; ///< Arguments after the flag
+            size_t Required;   ///< Number of arguments that must be given
+            int (*Run)(const std::vector<std::string> &args); ///< Returns the exit code
+        };
+
+        const Entry ENTRIES[] = {
+            {"--bench-crv", "<curve_file.crv> [iterations]", 1, [](const std::vector<std::string> &args)
+             { Assets::BenchmarkCRV(args[0], static_cast<int>(Argument(args, 1, 5))); return 0; }},
+            {"--bench-followers", "<curve_file.crv> [followers] [steps]", 1, [](const std::vector<std::string> &args)
+             { Benchmarks::Followers(args[0], Argument(args, 1, 100000), static_cast<int>(Argument(args, 2, 200))); return 0; }},
+            {"--bench-transforms", "[nodes] [iterations]", 0, [](const std::vector<std::string> &args)
+             { Benchmarks::Transforms(Argument(args, 0, 100000), static_cast<int>(Argument(args, 1, 50))); return 0; }},
+            {"--bench-culling", "[boxes] [iterations]", 0, [](const std::vector<std::string> &args)
+             { Benchmarks::Culling(Argument(args, 0, 100000), static_cast<int>(Argument(args, 1, 50))); return 0; }},
+        };
+    }
+
+    bool Benchmarks::IsBenchmark(int argc, char *argv[])
+    {
+        return argc >= 2 && std::string(argv[1]).rfind("--bench-", 0) == 0;
+    }
+
+    int Benchmarks::Run(int argc, char *argv[])
+    {
+        std::string flag = argc >= 2 ? argv[1] : "";
+        std::vector<std::string> args(argv + std::min(argc, 2), argv + argc);
+
+        for (const Entry &entry : ENTRIES)
+        {
+            if (flag != entry.Flag)
+                continue;
+
+            if (args.size() < entry.Required)
+            {
+                std::cout << "[ERROR]: Usage: " << entry.Flag << " " << entry.Usage << std::endl;
+                return 1;
+            }
+
+            return entry.Run(args);
+        }
+
+        std::cout << "[ERROR]: Unknown benchmark " << flag << ", available:" << std::endl;
+        for (const Entry &entry : ENTRIES)
+            std::cout << "    " << entry.Flag << " " << entry.Usage << std::endl;
+        return 1;
+    }
+
+    void Benchmarks::Followers(const std::string &filename, size_t count, int steps)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // The GL-free evaluator, so the benchmark runs without a window
+        BSplineT<3> curve;
+        curve.SetControlPoints(Assets::LoadCurve(filename));
+        int segments = curve.SegmentCount();
+        if (segments <= 0 || count == 0)
+        {
+            std::cerr << "[ERROR] Nothing to benchmark in: " << filename << std::endl;
+            return;
+        }
+
+        steps = std::max(1, steps);
+        const float step = 1.0f / 120.0f;
+
+        unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<unsigned> threads;
+        for (unsigned n = 1; n < hardware; n *= 2)
+            threads.push_back(n);
+        threads.push_back(hardware);
+
+        double single = 0.0;
+        for (unsigned n : threads)
+        {
+            // Same followers for every run: spread over the curve with different speeds
+            SplineFollowers followers;
+            for (size_t i = 0; i < count; i++)
+                followers.Add(0.5f + (i % 11) * 0.1f, static_cast<float>(segments) * i / count);
+
+            JobSystem jobs(n - 1);
+            JobSystem *pool = n > 1 ? &jobs : nullptr;
+
+            auto start = Clock::now();
+            for (int s = 0; s < steps; s++)
+                followers.Update(curve, step, pool);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (n == 1)
+                single = seconds;
+
+            // Results must not depend on the thread count
+            glm::vec3 checksum(0.0f);
+            for (const glm::vec3 &p : followers.Positions())
+                checksum += p;
+
+            std::cout << "[BENCH]: " << n << " thread(s): " << count << " followers, " << seconds * 1000.0 / steps << " ms/step, "
+                      << count * steps / seconds / 1e6 << " Mfollowers/s, speedup " << single / seconds << "x, "
+                      << jobs.StealCount() << " steals, checksum (" << checksum.x << ", " << checksum.y << ", " << checksum.z << ")" << std::endl;
+        }
+    }
+
+    void Benchmarks::Transforms(size_t nodes, int iterations)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        nodes = std::max<size_t>(nodes, 1);
+        iterations = std::max(1, iterations);
+
+        // Tree: every node gets 8 children until the tree is 4 levels deep, then new roots start
+        TransformHierarchy hierarchy;
+        std::vector<int> parents;
+        std::vector<int> depth;
+        for (size_t i = 0; i < nodes; i++)
+        {
+            int parent = TransformHierarchy::NONE;
+            if (i > 0 && depth[(i - 1) / 8] < 3)
+                parent = static_cast<int>((i - 1) / 8);
+
+            hierarchy.Create(parent);
+            parents.push_back(parent);
+            depth.push_back(parent == TransformHierarchy::NONE ? 0 : depth[parent] + 1);
+        }
+
+        auto pose = [](size_t i, int frame, glm::vec3 &position, glm::vec3 &front, glm::vec3 &up, glm::vec3 &right)
+        {
+            float angle = 0.001f * static_cast<float>(i + frame);
+            position = glm::vec3(static_cast<float>(i % 17), 0.1f * frame, 1.0f);
+            front = glm::vec3(std::sin(angle), 0.0f, std::cos(angle));
+            up = glm::vec3(0.0f, 1.0f, 0.0f);
+            right = glm::cross(up, front);
+        };
+
+        // Baseline: translate * rotate * scale per object, then parent * local, all full mat4 products
+        std::vector<glm::mat4> world(nodes);
+        double chain = 1e30;
+        for (int it = 0; it < iterations; it++)
+        {
+            auto start = Clock::now();
+            for (size_t i = 0; i < nodes; i++)
+            {
+                glm::vec3 position, front, up, right;
+                pose(i, it, position, front, up, right);
+
+                glm::mat4 rotation(1.0f);
+                rotation[0] = glm::vec4(right, 0.0f);
+                rotation[1] = glm::vec4(up, 0.0f);
+                rotation[2] = glm::vec4(front, 0.0f);
+                glm::mat4 local = glm::translate(glm::mat4(1.0f), position) * rotation * glm::scale(glm::mat4(1.0f), glm::vec3(1.0f));
+                world[i] = parents[i] == TransformHierarchy::NONE ? local : world[parents[i]] * local;
+            }
+            chain = std::min(chain, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        auto run = [&](const char *name, JobSystem *jobs)
+        {
+            double best = 1e30;
+            for (int it = 0; it < iterations; it++)
+            {
+                for (size_t i = 0; i < nodes; i++)
+                {
+                    glm::vec3 position, front, up, right;
+                    pose(i, it, position, front, up, right);
+                    hierarchy.SetPosition(static_cast<int>(i), position);
+                    hierarchy.SetOrientation(static_cast<int>(i), front, up);
+                }
+
+                auto start = Clock::now();
+                hierarchy.Update(jobs);
+                best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+            }
+
+            std::cout << "[BENCH]: " << name << ": " << nodes << " nodes, " << best * 1000.0 << " ms, "
+                      << nodes / best / 1e6 << " Mnodes/s, " << chain / best << "x vs. mat4 chain" << std::endl;
+        };
+
+        std::cout << "[BENCH]: mat4 chain               : " << nodes << " nodes, " << chain * 1000.0 << " ms, " << nodes / chain / 1e6 << " Mnodes/s" << std::endl;
+
+        run("hierarchy, 1 thread      ", nullptr);
+
+        JobSystem jobs;
+        std::string parallel = "hierarchy, " + std::to_string(jobs.WorkerCount() + 1) + " thread(s)";
+        run(parallel.c_str(), &jobs);
+    }
+
+    void Benchmarks::Culling(size_t count, int iterations)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        count = std::max<size_t>(count, 1);
+        iterations = std::max(1, iterations);
+
+        // Boxes scattered in a 200 unit cube around a camera at the origin looking down -Z
+        std::srand(1234);
+        auto random = [](float min, float max)
+        { return min + (max - min) * static_cast<float>(std::rand()) / RAND_MAX; };
+
+        std::vector<AABB> boxes(count);
+        for (AABB &box : boxes)
+        {
+            glm::vec3 center(random(-100.0f, 100.0f), random(-100.0f, 100.0f), random(-100.0f, 100.0f));
+            glm::vec3 extents(random(0.25f, 1.0f), random(0.25f, 1.0f), random(0.25f, 1.0f));
+            box = AABB(center - extents, center + extents);
+        }
+
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        Frustum frustum(glm::perspective(glm::radians(45.0f), 1.25f, 0.1f, 100.0f) * view);
+
+        // Baseline: every box against the frustum
+        int expected = 0;
+        double brute = 1e30;
+        for (int it = 0; it < iterations; it++)
+        {
+            auto start = Clock::now();
+            expected = 0;
+            for (const AABB &box : boxes)
+                expected += frustum.Test(box) != Frustum::OUTSIDE;
+            brute = std::min(brute, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        SceneBVH bvh;
+        for (const AABB &box : boxes)
+            bvh.Add(box);
+
+        auto start = Clock::now();
+        bvh.Update();
+        double build = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<uint8_t> visible;
+        int found = 0;
+        double cull = 1e30;
+        for (int it = 0; it < iterations; it++)
+        {
+            start = Clock::now();
+            found = bvh.Cull(frustum, visible);
+            cull = std::min(cull, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        // Moving objects: every box shifts a little, the tree is refitted instead of rebuilt
+        double refit = 1e30;
+        for (int it = 0; it < iterations; it++)
+        {
+            glm::vec3 offset(0.01f * static_cast<float>(it % 7), 0.0f, 0.0f);
+            for (size_t i = 0; i < count; i++)
+                bvh.SetBounds(static_cast<int>(i), AABB(boxes[i].Min + offset, boxes[i].Max + offset));
+
+            start = Clock::now();
+            bvh.Update();
+            refit = std::min(refit, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        std::cout << "[BENCH]: " << count << " boxes, " << expected << " visible" << std::endl;
+        std::cout << "[BENCH]: brute force : " << brute * 1000.0 << " ms" << std::endl;
+        std::cout << "[BENCH]: BVH cull    : " << cull * 1000.0 << " ms, " << brute / cull << "x, build " << build * 1000.0
+                  << " ms, refit " << refit * 1000.0 << " ms" << std::endl;
+
+        if (found != expected)
+            std::cout << "[ERROR]: BVH found " << found << " visible boxes, expected " << expected << std::endl;
+    }
+}
@@ -9,12 +9,12 @@ namespace RA
         SetOrientation(glm::vec3(0.f, 0.f, -1.f), GetUp());
 
         // Initialize view matrix
-        _view_matrix = glm::lookAt(_position, _position + _front, _up);
+        _view_matrix = glm::lookAt(_position, _position + GetFront(), GetUp());
     }
 
     void Camera::_RecalculateViewMatrix()
     {
-        _view_matrix = glm::lookAt(_position, _position + _front, _up);
+        _view_matrix = glm::lookAt(_position, _position + GetFront(), GetUp());
     }
 
     glm::mat4 Camera::GetViewMatrix()
@@ -0,0 +1,376 @@
+// Local Headers
+#include "CurveBVH.hpp"
+#include "JobSystem.hpp"
+// Standard Headers
+#include <algorithm>
+#include <cmath>
+
+namespace RA
+{
+    namespace
+    {
+        constexpr int LEAF_SIZE = 4;
+        constexpr int STACK_SIZE = 64;
+        constexpr int NEWTON_ITERATIONS = 5;
+        constexpr size_t CLOSEST_POINTS_BATCH = 256;
+        constexpr float HUGE_INVERSE = 1e30f;
+
+        /// Squared distance from a point to an AABB (0 if inside).
+        float DistanceSquared(const glm::vec3 &point, const glm::vec3 &min, const glm::vec3 &max)
+        {
+            glm::vec3 d = glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+            return glm::dot(d, d);
+        }
+
+        /// Inverse of a ray direction for RayBox. A zero component becomes a large value of the same sign
+        /// instead of inf, so a ray parallel to a slab never computes 0 * inf = NaN when it starts on a box face.
+        glm::vec3 InverseDirection(const glm::vec3 &direction)
+        {
+            glm::vec3 inv;
+            for (int i = 0; i < 3; i++)
+                inv[i] = direction[i] != 0.0f ? 1.0f / direction[i] : std::copysign(HUGE_INVERSE, direction[i]);
+            return inv;
+        }
+
+        /// Slab test; returns the entry distance along the ray or -1 on a miss.
+        float RayBox(const glm::vec3 &origin, const glm::vec3 &inv_direction, const glm::vec3 &min, const glm::vec3 &max)
+        {
+            glm::vec3 t0 = (min - origin) * inv_direction;
+            glm::vec3 t1 = (max - origin) * inv_direction;
+            glm::vec3 t_near = glm::min(t0, t1);
+            glm::vec3 t_far = glm::max(t0, t1);
+
+            float enter = std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, 0.0f));
+            float exit = std::min(std::min(t_far.x, t_far.y), t_far.z);
+            return enter <= exit ? enter : -1.0f;
+        }
+    }
+
+    void CurveBVH::Build(const std::vector<glm::vec3> &control_points)
+    {
+        _Segments.clear();
+        _Min.clear();
+        _Max.clear();
+        _Order.clear();
+        _Nodes.clear();
+
+        if (control_points.size() < 4)
+            return;
+
+        size_t count = control_points.size() - 3;
+        _Segments.resize(count);
+        _Min.resize(count);
+        _Max.resize(count);
+        _Order.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const glm::vec3 &P0 = control_points[i];
+            const glm::vec3 &P1 = control_points[i + 1];
+            const glm::vec3 &P2 = control_points[i + 2];
+            const glm::vec3 &P3 = control_points[i + 3];
+
+            // Power form of the uniform cubic B-spline basis (same basis as BSpline::GetPoint).
+            Segment &s = _Segments[i];
+            s.A = (-P0 + 3.0f * P1 - 3.0f * P2 + P3) / 6.0f;
+            s.B = (3.0f * P0 - 6.0f * P1 + 3.0f * P2) / 6.0f;
+            s.C = (-3.0f * P0 + 3.0f * P2) / 6.0f;
+            s.D = (P0 + 4.0f * P1 + P2) / 6.0f;
+
+            // Convex hull property: the segment lies inside the box of its control points.
+            _Min[i] = glm::min(glm::min(P0, P1), glm::min(P2, P3));
+            _Max[i] = glm::max(glm::max(P0, P1), glm::max(P2, P3));
+            _Order[i] = static_cast<int>(i);
+        }
+
+        _Nodes.reserve(2 * (count / LEAF_SIZE + 1));
+        _Nodes.emplace_back();
+        _BuildNode(0, 0, static_cast<int>(count));
+    }
+
+    void CurveBVH::_BuildNode(int index, int first, int count)
+    {
+        glm::vec3 min(std::numeric_limits<float>::max());
+        glm::vec3 max(-std::numeric_limits<float>::max());
+        glm::vec3 cmin = min;
+        glm::vec3 cmax = max;
+
+        for (int i = first; i < first + count; i++)
+        {
+            int s = _Order[i];
+            min = glm::min(min, _Min[s]);
+            max = glm::max(max, _Max[s]);
+
+            glm::vec3 centroid = (_Min[s] + _Max[s]) * 0.5f;
+            cmin = glm::min(cmin, centroid);
+            cmax = glm::max(cmax, centroid);
+        }
+
+        _Nodes[index].Min = min;
+        _Nodes[index].Max = max;
+
+        if (count <= LEAF_SIZE)
+        {
+            _Nodes[index].First = first;
+            _Nodes[index].Count = count;
+            return;
+        }
+
+        // Median split along the longest axis of the centroid bounds.
+        glm::vec3 extent = cmax - cmin;
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        int half = count / 2;
+
+        std::nth_element(_Order.begin() + first, _Order.begin() + first + half, _Order.begin() + first + count,
+                         [this, axis](int a, int b)
+                         { return _Min[a][axis] + _Max[a][axis] < _Min[b][axis] + _Max[b][axis]; });
+
+        // Children are allocated as a pair, so only the first index is stored.
+        int left = static_cast<int>(_Nodes.size());
+        _Nodes.emplace_back();
+        _Nodes.emplace_back();
+        _Nodes[index].First = left;
+        _Nodes[index].Count = 0;
+
+        _BuildNode(left, first, half);
+        _BuildNode(left + 1, first + half, count - half);
+    }
+
+    CurveHit CurveBVH::_ClosestOnSegment(int segment, const glm::vec3 &point) const
+    {
+        const Segment &s = _Segments[segment];
+
+        // Coarse start: the best of a few samples, so Newton converges to the global minimum
+        // on typical (not strongly looping) segments.
+        float best_t = 0.0f;
+        float best_d = std::numeric_limits<float>::max();
+        for (int i = 0; i <= 4; i++)
+        {
+            float t = i * 0.25f;
+            glm::vec3 d = s.Point(t) - point;
+            float dd = glm::dot(d, d);
+            if (dd < best_d)
+            {
+                best_d = dd;
+                best_t = t;
+            }
+        }
+
+        // Newton on f(t) = (P(t) - Q) . P'(t), f'(t) = |P'(t)|^2 + (P(t) - Q) . P''(t).
+        float t = best_t;
+        for (int i = 0; i < NEWTON_ITERATIONS; i++)
+        {
+            glm::vec3 d = s.Point(t) - point;
+            glm::vec3 d1 = s.First(t);
+            float f = glm::dot(d, d1);
+            float df = glm::dot(d1, d1) + glm::dot(d, s.Second(t));
+            if (df <= 1e-12f)
+                break;
+
+            float next = glm::clamp(t - f / df, 0.0f, 1.0f);
+            bool converged = std::abs(next - t) < 1e-5f;
+            t = next;
+            if (converged)
+                break;
+        }
+
+        glm::vec3 p = s.Point(t);
+        float dd = glm::dot(p - point, p - point);
+        if (dd > best_d)
+        {
+            t = best_t;
+            p = s.Point(t);
+            dd = best_d;
+        }
+
+        CurveHit hit;
+        hit.Segment = segment;
+        hit.T = t;
+        hit.Point = p;
+        hit.Distance = std::sqrt(dd);
+        return hit;
+    }
+
+    CurveHit CurveBVH::ClosestPoint(const glm::vec3 &point, float max_distance) const
+    {
+        CurveHit best;
+        if (_Nodes.empty())
+            return best;
+
+        float best_d = max_distance < std::numeric_limits<float>::max() ? max_distance * max_distance : max_distance;
+
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const Node &node = _Nodes[stack[--top]];
+            if (DistanceSquared(point, node.Min, node.Max) >= best_d)
+                continue;
+
+            if (node.Count > 0)
+            {
+                for (int i = node.First; i < node.First + node.Count; i++)
+                {
+                    int s = _Order[i];
+                    if (DistanceSquared(point, _Min[s], _Max[s]) >= best_d)
+                        continue;
+
+                    CurveHit hit = _ClosestOnSegment(s, point);
+                    if (hit.Distance * hit.Distance < best_d)
+                    {
+                        best_d = hit.Distance * hit.Distance;
+                        best = hit;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited next.
+            float dl = DistanceSquared(point, _Nodes[node.First].Min, _Nodes[node.First].Max);
+            float dr = DistanceSquared(point, _Nodes[node.First + 1].Min, _Nodes[node.First + 1].Max);
+            if (dl < dr)
+            {
+                stack[top++] = node.First + 1;
+                stack[top++] = node.First;
+            }
+            else
+            {
+                stack[top++] = node.First;
+                stack[top++] = node.First + 1;
+            }
+        }
+
+        return best;
+    }
+
+    CurveHit CurveBVH::_RayOnSegment(int segment, const glm::vec3 &origin, const glm::vec3 &direction) const
+    {
+        const Segment &s = _Segments[segment];
+
+        // Squared distance from P(t) to the ray line: g(t) = |r - (r . d) d|^2 with r = P(t) - O.
+        auto perpendicular = [&](float t)
+        {
+            glm::vec3 r = s.Point(t) - origin;
+            return r - glm::dot(r, direction) * direction;
+        };
+
+        float best_t = 0.0f;
+        float best_d = std::numeric_limits<float>::max();
+        for (int i = 0; i <= 4; i++)
+        {
+            float t = i * 0.25f;
+            glm::vec3 e = perpendicular(t);
+            float dd = glm::dot(e, e);
+            if (dd < best_d)
+            {
+                best_d = dd;
+                best_t = t;
+            }
+        }
+
+        // Newton on g'(t)/2 = e . P'(t), derivative |P'_perp|^2 + e . P''(t).
+        float t = best_t;
+        for (int i = 0; i < NEWTON_ITERATIONS; i++)
+        {
+            glm::vec3 e = perpendicular(t);
+            glm::vec3 d1 = s.First(t);
+            glm::vec3 d1_perp = d1 - glm::dot(d1, direction) * direction;
+            float f = glm::dot(e, d1);
+            float df = glm::dot(d1_perp, d1_perp) + glm::dot(e, s.Second(t));
+            if (df <= 1e-12f)
+                break;
+
+            float next = glm::clamp(t - f / df, 0.0f, 1.0f);
+            bool converged = std::abs(next - t) < 1e-5f;
+            t = next;
+            if (converged)
+                break;
+        }
+
+        glm::vec3 e = perpendicular(t);
+        float dd = glm::dot(e, e);
+        if (dd > best_d)
+        {
+            t = best_t;
+            dd = best_d;
+        }
+
+        CurveHit hit;
+        hit.Segment = segment;
+        hit.T = t;
+        hit.Point = s.Point(t);
+        hit.Distance = std::sqrt(dd);
+        hit.RayDistance = glm::dot(hit.Point - origin, direction);
+        return hit;
+    }
+
+    CurveHit CurveBVH::Pick(const glm::vec3 &origin, const glm::vec3 &direction, float radius) const
+    {
+        CurveHit best;
+        if (_Nodes.empty() || glm::length(direction) <= 0.0f)
+            return best;
+
+        glm::vec3 dir = glm::normalize(direction);
+        glm::vec3 inv = InverseDirection(dir);
+        glm::vec3 pad(radius);
+        float best_ray = std::numeric_limits<float>::max();
+
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const Node &node = _Nodes[stack[--top]];
+
+            // Boxes are grown by the tube radius, which turns the capsule chain test into a ray/box test.
+            float enter = RayBox(origin, inv, node.Min - pad, node.Max + pad);
+            if (enter < 0.0f || enter > best_ray)
+                continue;
+
+            if (node.Count > 0)
+            {
+                for (int i = node.First; i < node.First + node.Count; i++)
+                {
+                    int s = _Order[i];
+                    float segment_enter = RayBox(origin, inv, _Min[s] - pad, _Max[s] + pad);
+                    if (segment_enter < 0.0f || segment_enter > best_ray)
+                        continue;
+
+                    CurveHit hit = _RayOnSegment(s, origin, dir);
+                    if (hit.Distance <= radius && hit.RayDistance >= 0.0f && hit.RayDistance < best_ray)
+                    {
+                        best_ray = hit.RayDistance;
+                        best = hit;
+                    }
+                }
+                continue;
+            }
+
+            stack[top++] = node.First;
+            stack[top++] = node.First + 1;
+        }
+
+        return best;
+    }
+
+    void CurveBVH::ClosestPoints(const std::vector<glm::vec3> &points, std::vector<CurveHit> &out, JobSystem *jobs) const
+    {
+        out.resize(points.size());
+
+        // Not worth waking the workers for small batches.
+        if (!jobs || points.size() <= CLOSEST_POINTS_BATCH)
+        {
+            for (size_t i = 0; i < points.size(); i++)
+                out[i] = ClosestPoint(points[i]);
+            return;
+        }
+
+        jobs->ParallelFor(points.size(), CLOSEST_POINTS_BATCH, [&](size_t begin, size_t end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                                  out[i] = ClosestPoint(points[i]); });
+    }
+}
@@ -0,0 +1,109 @@
+// Local Headers
+#include "Frustum.hpp"
+// Standard Headers
+#include <cmath>
+#include <limits>
+// External Headers
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RA_FRUSTUM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace RA
+{
+    Frustum::Frustum()
+    {
+        // Padding planes only: everything is inside
+        for (int i = 0; i < PLANES; i++)
+        {
+            _nx[i] = _ny[i] = _nz[i] = 0.0f;
+            _d[i] = std::numeric_limits<float>::max();
+        }
+    }
+
+    Frustum::Frustum(const glm::mat4 &view_projection) : Frustum()
+    {
+        // Rows of the matrix (glm is column-major)
+        glm::vec4 row[4];
+        for (int i = 0; i < 4; i++)
+            row[i] = glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+
+        // Left, right, bottom, top, near, far
+        glm::vec4 planes[6] = {row[3] + row[0], row[3] - row[0],
+                               row[3] + row[1], row[3] - row[1],
+                               row[3] + row[2], row[3] - row[2]};
+
+        for (int i = 0; i < 6; i++)
+        {
+            // Normalized so the sphere test can compare distances with the radius
+            float length = glm::length(glm::vec3(planes[i]));
+            glm::vec4 plane = length > 0.0f ? planes[i] / length : planes[i];
+
+            _nx[i] = plane.x;
+            _ny[i] = plane.y;
+            _nz[i] = plane.z;
+            _d[i] = plane.w;
+        }
+    }
+
+    namespace
+    {
+        /// Signed distance of the center to each plane, against a radius of |n|.extents + radius.
+        Frustum::Result Classify(const float *nx, const float *ny, const float *nz, const float *d, int planes,
+                                 const glm::vec3 &center, const glm::vec3 &extents, float radius)
+        {
+#ifdef RA_FRUSTUM_SSE
+            const __m128 sign = _mm_set1_ps(-0.0f);
+            const __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+            const __m128 ex = _mm_set1_ps(extents.x), ey = _mm_set1_ps(extents.y), ez = _mm_set1_ps(extents.z);
+            const __m128 r = _mm_set1_ps(radius);
+
+            int outside = 0;
+            int crossing = 0;
+            for (int i = 0; i < planes; i += 4)
+            {
+                __m128 px = _mm_load_ps(nx + i), py = _mm_load_ps(ny + i), pz = _mm_load_ps(nz + i);
+
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, cx), _mm_mul_ps(py, cy)),
+                                             _mm_add_ps(_mm_mul_ps(pz, cz), _mm_load_ps(d + i)));
+                __m128 reach = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, px), ex), _mm_mul_ps(_mm_andnot_ps(sign, py), ey)),
+                                          _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, pz), ez), r));
+
+                outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+                crossing |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, reach), _mm_setzero_ps()));
+            }
+#else
+            bool outside = false;
+            bool crossing = false;
+            for (int i = 0; i < planes; i++)
+            {
+                float distance = nx[i] * center.x + ny[i] * center.y + nz[i] * center.z + d[i];
+                float reach = std::abs(nx[i]) * extents.x + std::abs(ny[i]) * extents.y + std::abs(nz[i]) * extents.z + radius;
+
+                outside |= distance + reach < 0.0f;
+                crossing |= distance - reach < 0.0f;
+            }
+#endif
+            if (outside)
+                return Frustum::OUTSIDE;
+            return crossing ? Frustum::INTERSECT : Frustum::INSIDE;
+        }
+    }
+
+    Frustum::Result Frustum::Test(const glm::vec3 &center, const glm::vec3 &extents) const
+    {
+        return Classify(_nx, _ny, _nz, _d, PLANES, center, extents, 0.0f);
+    }
+
+    Frustum::Result Frustum::Test(const AABB &box) const
+    {
+        if (!box.Valid())
+            return OUTSIDE;
+        return Test(box.Center(), box.Extents());
+    }
+
+    Frustum::Result Frustum::Test(const glm::vec3 &center, float radius) const
+    {
+        return Classify(_nx, _ny, _nz, _d, PLANES, center, glm::vec3(0.0f), radius);
+    }
+}
@@ -59,65 +59,63 @@ void RA::Input::ProcessCameraInput(GLFWwindow *window, float delta_time, RA::Tra
     }
 }
 
-void RA::Input::ProcessBSplineFollow(GLFWwindow *window, float delta_time, std::shared_ptr<Mesh> mesh, std::shared_ptr<Polyline> front_vec, std::shared_ptr<BSpline> spline)
-{
-    static const float speed = 1.0f;
+bool RA::Input::_Following = false;
+bool RA::Input::_KeyPressed = false;
 
-    static bool follow_spline = false;
-    static bool space_pressed_last_frame = false;
-    static float current_t = 0;
-    static int current_segment = 0;
+bool RA::Input::IsFollowKeyPressed(GLFWwindow *window)
+{
+    return glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+}
 
-    bool space_pressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+bool RA::Input::IsTessellationKeyPressed(GLFWwindow *window)
+{
+    return glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS;
+}
 
-    if (space_pressed && !space_pressed_last_frame)
+void RA::Input::ProcessFollowToggle(bool key_pressed, SplineFollowers &followers)
+{
+    if (key_pressed && !_KeyPressed)
     {
-        follow_spline = !follow_spline;
-        current_t = 0.0f;
-        current_segment = 0;
+        _Following = !_Following;
+        followers.Reset();
     }
-    space_pressed_last_frame = space_pressed;
+    _KeyPressed = key_pressed;
+}
 
-    if (!follow_spline || spline->GetControlPoints().size() < 4)
+void RA::Input::ProcessBSplineFollow(float delta_time, std::shared_ptr<BSpline> spline, SplineFollowers &followers, JobSystem *jobs, std::vector<glm::vec3> *trail_points)
+{
+    if (!_Following || spline->SegmentCount() == 0 || followers.Size() == 0)
         return;
 
-    // Advance current_t based on speed and delta_time
-    current_t += speed * delta_time;
+    followers.Update(*spline, delta_time, jobs);
 
-    size_t num_segments = spline->GetControlPoints().size() - 3;
-
-    // Loop along the spline
-    while (current_t >= 1.0f)
-    {
-        current_t -= 1.0f;
-        current_segment++;
+    const SplineFollower &follower = followers[0];
+    _PrintAxisDifference(spline->GetTangent(follower.Segment, follower.T), delta_time);
 
-        if (current_segment >= num_segments)
-            current_segment = 0; // loop to start
-    }
+    if (trail_points)
+        trail_points->push_back(followers.Positions()[0]);
+}
 
-    // Compute position, tangent, normal on B-spline
-    glm::vec3 position = spline->GetPoint(current_segment, current_t);
-    glm::vec3 tangent = spline->GetTangent(current_segment, current_t);
-    glm::vec3 normal = spline->GetNormal(current_segment, current_t);
-    glm::vec3 binormal = glm::cross(tangent, normal);
+void RA::Input::ApplyBSplineFollow(const SplineFollower &follower, float alpha, TransformHierarchy &scene, TransformHierarchy::Node node, std::shared_ptr<BSpline> spline)
+{
+    int num_segments = spline->SegmentCount();
+    if (num_segments == 0)
+        return;
 
-    glm::vec3 current_front(tangent);
+    // Interpolate the curve parameter, not the position, so the object stays on the curve.
+    int current_segment;
+    float current_t;
+    follower.Interpolate(alpha, num_segments, current_segment, current_t);
 
-    _PrintAxisDifference(current_front, delta_time);
+    // Orientation: blend the frames of the two simulated steps; the Frenet normal can swing
+    // quickly near inflection points, and blending keeps the motion as smooth as the simulation.
+    int previous_segment = std::min(follower.PreviousSegment, num_segments - 1);
+    int last_segment = std::min(follower.Segment, num_segments - 1);
+    glm::quat previous = Transform::LookRotation(spline->GetTangent(previous_segment, follower.PreviousT), spline->GetNormal(previous_segment, follower.PreviousT));
+    glm::quat current = Transform::LookRotation(spline->GetTangent(last_segment, follower.T), spline->GetNormal(last_segment, follower.T));
 
-    // Update mesh
-    if (mesh)
-    {
-        mesh->SetPosition(position);
-        mesh->SetOrientation(tangent, normal, binormal);
-    }
-
-    if (front_vec)
-    {
-        front_vec->SetPosition(position);
-        front_vec->SetOrientation(tangent, normal, binormal);
-    }
+    scene.SetPosition(node, spline->GetPoint(current_segment, current_t));
+    scene.SetRotation(node, Transform::Nlerp(previous, current, alpha));
 }
 
 void RA::Input::_ComputeRotationFromTo(const glm::vec3 &s, const glm::vec3 &e, glm::vec3 &out_axis, float &out_angle)
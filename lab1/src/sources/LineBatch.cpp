@@ -0,0 +1,175 @@
+// Local Headers
+#include "LineBatch.hpp"
+#include "GLState.hpp"
+#include "Polyline.hpp"
+// Standard Headers
+#include <algorithm>
+#include <utility>
+
+namespace RA
+{
+    LineBatch::LineBatch()
+        : Renderable()
+    {
+        GLState::BindVertexArray(VAO);
+
+        glGenBuffers(1, &_pointVBO);
+        glGenBuffers(1, &_indexVBO);
+
+        // One instance per segment: points i and i + 1 (layout locations 0 and 1) and their line indices
+        // (layout locations 4 and 5); the timestamp attributes of the trail stay disabled
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _pointVBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)sizeof(glm::vec3));
+
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _indexVBO);
+        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)0);
+        glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)sizeof(float));
+
+        for (GLuint location : {0u, 1u, 4u, 5u})
+        {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+
+        GLState::BindVertexArray(0);
+
+        glGenBuffers(1, &_lineBuffer);
+        glGenTextures(1, &_lineTexture);
+    }
+
+    LineBatch::~LineBatch()
+    {
+        GLState::DeleteTexture(_lineTexture);
+        GLState::DeleteBuffer(_lineBuffer);
+        GLState::DeleteBuffer(_indexVBO);
+        GLState::DeleteBuffer(_pointVBO);
+    }
+
+    void LineBatch::Clear()
+    {
+        _lines.clear();
+    }
+
+    void LineBatch::Add(Polyline &line)
+    {
+        if (line.GetPoints().size() < 2)
+            return;
+
+        _lines.push_back(&line);
+    }
+
+    void LineBatch::_Reserve(size_t points)
+    {
+        if (points <= _pointCapacity)
+            return;
+
+        _pointCapacity = std::max(points, _pointCapacity * 2);
+
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _pointVBO);
+        glBufferData(GL_ARRAY_BUFFER, _pointCapacity * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _indexVBO);
+        glBufferData(GL_ARRAY_BUFFER, _pointCapacity * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+
+        // The new storage is empty, so every slot is filled again
+        _slots.clear();
+    }
+
+    void LineBatch::Draw(Shader &shader)
+    {
+        if (_lines.empty())
+            return;
+
+        // Every line gets a slot of its buffer capacity plus a break point, in the order the lines were added
+        _layout.clear();
+        _attributes.clear();
+        size_t total = 0;
+
+        for (Polyline *line : _lines)
+        {
+            line->Upload();
+            _layout.push_back({line->GetId(), total, line->GetCapacity(), line->GetPoints().size()});
+            total += line->GetCapacity() + 1;
+
+            glm::mat4 model = line->GetModelMatrix();
+            _attributes.push_back(model[0]);
+            _attributes.push_back(model[1]);
+            _attributes.push_back(model[2]);
+            _attributes.push_back(model[3]);
+            _attributes.push_back(line->GetColor());
+            _attributes.push_back(glm::vec4(line->GetLineSize(), 0.0f, 0.0f, 0.0f));
+        }
+
+        _Reserve(total);
+
+        for (size_t i = 0; i < _layout.size(); i++)
+        {
+            Polyline &line = *_lines[i];
+            const Slot &slot = _layout[i];
+            bool kept = i < _slots.size() && _slots[i].Id == slot.Id && _slots[i].Offset == slot.Offset && _slots[i].Capacity == slot.Capacity;
+
+            // A line that kept its slot copies only its changed points; otherwise the whole line is copied
+            std::pair<size_t, size_t> range = line.TakeCopyRange();
+            if (!kept)
+                range = {0, slot.Count};
+
+            if (range.first < range.second)
+            {
+                GLState::BindBuffer(GL_COPY_READ_BUFFER, line.Upload());
+                GLState::BindBuffer(GL_COPY_WRITE_BUFFER, _pointVBO);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.first * sizeof(glm::vec3),
+                                    (slot.Offset + range.first) * sizeof(glm::vec3), (range.second - range.first) * sizeof(glm::vec3));
+            }
+
+            // The indices only change with the slot or the number of points
+            if (!kept || _slots[i].Count != slot.Count)
+            {
+                _indices.assign(slot.Capacity + 1, -1.0f);
+                std::fill_n(_indices.begin(), slot.Count, static_cast<float>(i));
+
+                GLState::BindBuffer(GL_ARRAY_BUFFER, _indexVBO);
+                glBufferSubData(GL_ARRAY_BUFFER, slot.Offset * sizeof(float), _indices.size() * sizeof(float), _indices.data());
+            }
+        }
+
+        std::swap(_slots, _layout);
+
+        // Upload the per-line attributes, growing the GPU storage geometrically
+        GLState::BindBuffer(GL_TEXTURE_BUFFER, _lineBuffer);
+        GLState::BindTexture(0, GL_TEXTURE_BUFFER, _lineTexture);
+        if (_attributes.size() > _lineCapacity)
+        {
+            _lineCapacity = std::max(_attributes.size(), _lineCapacity * 2);
+            glBufferData(GL_TEXTURE_BUFFER, _lineCapacity * sizeof(glm::vec4), nullptr, GL_STREAM_DRAW);
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, _lineBuffer);
+        }
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, _attributes.size() * sizeof(glm::vec4), _attributes.data());
+
+        shader.SetUniform("USE_LINE_BUFFER", true);
+        shader.SetUniform("LINES", 0);
+
+        // Segments across a break point or unused points are dropped by the shader
+        GLState::BindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(total - 1));
+    }
+
+    void LineBatch::Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat)
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        shader->Use();
+        shader->SetUniform("VIEW_MAT", view_mat);
+        shader->SetUniform("PERS_MAT", pers_mat);
+        shader->SetUniform("VIEWPORT", glm::vec2(viewport[2], viewport[3]));
+        shader->SetUniform("FADE", false);
+
+        // The segments are screen-space quads, so they must be filled even in wireframe mode
+        GLenum polygon_mode = GLState::GetPolygonMode();
+        GLState::PolygonMode(GL_FILL);
+
+        Draw(*shader);
+
+        GLState::PolygonMode(polygon_mode);
+    }
+}
@@ -1,9 +1,11 @@
 // Local Headers
 #include "Application.hpp"
 #include "Assets.hpp"
+#include "Benchmarks.hpp"
 // Standard Headers
 #include <iostream>
 #include <memory>
+#include <string>
 // External Headers
 
 using namespace RA;
@@ -11,15 +13,34 @@ using namespace std;
 
 int main(int argc, char *argv[])
 {
+    // Curve tool: convert a text curve to the binary format.
+    if (argc >= 2 && string(argv[1]) == "--convert")
+    {
+        if (argc < 4)
+        {
+            cout << "[ERROR]: Usage: --convert <curve_file.crv> <curve_file.crvb>\n";
+            return 1;
+        }
+        return Assets::ConvertCRV(argv[2], argv[3]) ? 0 : 1;
+    }
+
+    // Benchmarks run instead of the application.
+    if (Benchmarks::IsBenchmark(argc, argv))
+        return Benchmarks::Run(argc, argv);
+
     if (argc < 3)
     {
-        cout << "[ERROR]: You need to provide 2 arguments: <object_file.obj> <curve_file.crv>\n";
+        cout << "[ERROR]: You need to provide 2 arguments: <object_file.obj> <curve_file.crv> [--trace <trace.json>]\n";
         return 1;
     }
 
     Assets::MeshFile = argv[1];
     Assets::CurveFile = argv[2];
 
+    // Optional profiling: the last frames are written as a Chrome trace at exit.
+    if (argc >= 5 && string(argv[3]) == "--trace")
+        Application::TraceFile = argv[4];
+
     Application::Instance = make_shared<Application>();
     Application::Instance->Run();
 
@@ -0,0 +1,102 @@
+// Local Headers
+#include "MappedFile.hpp"
+// Standard Headers
+#include <fstream>
+// External Headers
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RA
+{
+    MappedFile::MappedFile(const std::string &filename)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+            {
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping)
+                {
+                    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    if (view)
+                    {
+                        _file = file;
+                        _mapping = mapping;
+                        _data = static_cast<const char *>(view);
+                        _size = static_cast<size_t>(size.QuadPart);
+                        _mapped = true;
+                        _open = true;
+                        return;
+                    }
+                    CloseHandle(mapping);
+                }
+            }
+            CloseHandle(file);
+        }
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            struct stat info;
+            if (fstat(fd, &info) == 0 && info.st_size > 0)
+            {
+                void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (view != MAP_FAILED)
+                {
+                    madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                    _data = static_cast<const char *>(view);
+                    _size = static_cast<size_t>(info.st_size);
+                    _mapped = true;
+                    _open = true;
+                }
+            }
+            close(fd);
+
+            if (_mapped)
+                return;
+        }
+#endif
+
+        // Fallback: read the whole file (also covers empty files, which cannot be mapped).
+        std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+        if (!stream.is_open())
+            return;
+
+        _buffer.resize(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+        stream.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+
+        _data = _buffer.data();
+        _size = _buffer.size();
+        _open = true;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (!_mapped)
+            return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+        CloseHandle(static_cast<HANDLE>(_mapping));
+        CloseHandle(static_cast<HANDLE>(_file));
+#else
+        munmap(const_cast<char *>(_data), _size);
+#endif
+    }
+}
@@ -1,5 +1,7 @@
 // Local Headers
 #include "Mesh.hpp"
+#include "GLState.hpp"
+#include "RenderQueue.hpp"
 // Standard Headers
 #include <fstream>
 #include <sstream>
@@ -95,14 +97,26 @@ namespace RA
             _SetupMesh();
 
         // Bind the VAO containing vertex attribute configuration.
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
 
         // Draw the mesh using the indices stored in the EBO.
         // GL_TRIANGLES is used as the primitive type.
         glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(Indices.size()), GL_UNSIGNED_INT, 0);
+    }
+
+    void Mesh::Submit(RenderQueue &queue, std::shared_ptr<Shader> shader)
+    {
+        if (!_mesh_setup)
+            _SetupMesh();
 
-        // Unbind the VAO after drawing.
-        glBindVertexArray(0);
+        RenderQueue::DrawPacket packet;
+        packet.Program = shader;
+        packet.VAO = VAO;
+        packet.Mode = GL_TRIANGLES;
+        packet.Count = static_cast<GLsizei>(Indices.size());
+        packet.Indexed = true;
+        packet.Model = this->GetModelMatrix();
+        queue.Submit(packet);
     }
 
     void Mesh::_ComputeNormals()
@@ -170,6 +184,10 @@ namespace RA
 
         // Apply the transformation to all vertices.
         _ApplyTransform(transform);
+
+        // Keep the normalized box for culling.
+        bbox = _GetBoundingBox();
+        _bounds = AABB(bbox.first, bbox.second);
     }
 
     std::pair<glm::vec3, glm::vec3> Mesh::_GetBoundingBox()
@@ -211,20 +229,20 @@ namespace RA
     Mesh::~Mesh()
     {
         if (VBO[0])
-            glDeleteBuffers(1, &VBO[0]);
+            GLState::DeleteBuffer(VBO[0]);
         if (VBO[1])
-            glDeleteBuffers(1, &VBO[1]);
+            GLState::DeleteBuffer(VBO[1]);
         if (VBO[2])
-            glDeleteBuffers(1, &VBO[2]);
+            GLState::DeleteBuffer(VBO[2]);
         if (EBO)
-            glDeleteBuffers(1, &EBO);
+            GLState::DeleteBuffer(EBO);
     }
 
     // Uploads mesh data to the GPU and sets up vertex attribute pointers.
     void Mesh::_SetupMesh()
     {
         // Bind the VAO (created in the Renderable constructor).
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
 
         // Ensure the VBO for vertices exists; if not, generate it.
         if (VBO[0] == 0)
@@ -233,7 +251,7 @@ namespace RA
         }
 
         // Bind and upload vertex data.
-        glBindBuffer(GL_ARRAY_BUFFER, VBO[0]);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO[0]);
         glBufferData(GL_ARRAY_BUFFER, Vertices.size() * sizeof(glm::vec3), &Vertices[0], GL_STATIC_DRAW);
 
         // Set vertex attribute pointer for layout location 0.
@@ -247,7 +265,7 @@ namespace RA
             {
                 glGenBuffers(1, &VBO[1]);
             }
-            glBindBuffer(GL_ARRAY_BUFFER, VBO[1]);
+            GLState::BindBuffer(GL_ARRAY_BUFFER, VBO[1]);
             glBufferData(GL_ARRAY_BUFFER, Normals.size() * sizeof(glm::vec3), &Normals[0], GL_STATIC_DRAW);
             glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
             glEnableVertexAttribArray(1);
@@ -260,7 +278,7 @@ namespace RA
             {
                 glGenBuffers(1, &VBO[2]);
             }
-            glBindBuffer(GL_ARRAY_BUFFER, VBO[2]);
+            GLState::BindBuffer(GL_ARRAY_BUFFER, VBO[2]);
             glBufferData(GL_ARRAY_BUFFER, UVCoords.size() * sizeof(glm::vec2), &UVCoords[0], GL_STATIC_DRAW);
             glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void *)0);
             glEnableVertexAttribArray(2);
@@ -273,11 +291,11 @@ namespace RA
         }
 
         // Bind and upload index data.
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size() * sizeof(unsigned int), &Indices[0], GL_STATIC_DRAW);
 
         // Unbind the VAO (note: the EBO remains bound to the VAO).
-        glBindVertexArray(0);
+        GLState::BindVertexArray(0);
 
         _mesh_setup = true;
     }
@@ -1,11 +1,35 @@
 #include "Polyline.hpp"
+#include "GLState.hpp"
+#include "RenderQueue.hpp"
+#include <algorithm>
+#include <utility>
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
 namespace RA
 {
+    namespace
+    {
+        /// Id of the next polyline; 0 is never used.
+        uint64_t NextPolylineId = 1;
+
+        /// Extend the range [begin, end) by [first, last).
+        void ExtendRange(size_t &begin, size_t &end, size_t first, size_t last)
+        {
+            if (begin >= end)
+            {
+                begin = first;
+                end = last;
+                return;
+            }
+
+            begin = std::min(begin, first);
+            end = std::max(end, last);
+        }
+    }
+
     Polyline::Polyline(float line_size, glm::vec4 color)
-        : Renderable(), _VBO(0), _line_size(line_size), _color(color)
+        : Renderable(), _VBO(0), _id(NextPolylineId++), _line_size(line_size), _color(color)
     {
         _setup = false;
     }
@@ -13,51 +37,138 @@ namespace RA
     Polyline::~Polyline()
     {
         if (_VBO)
-            glDeleteBuffers(1, &_VBO);
+            GLState::DeleteBuffer(_VBO);
     }
 
     void Polyline::_SetupPolyline()
     {
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
 
         if (_VBO == 0)
         {
             glGenBuffers(1, &_VBO);
         }
 
-        glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-        glBufferData(GL_ARRAY_BUFFER, _points.size() * sizeof(glm::vec3), _points.data(), GL_STATIC_DRAW);
+        // The VAO keeps referring to _VBO when its storage is reallocated, so the attribute is specified once
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _VBO);
 
-        // Vertex attribute for position (layout location 0)
+        // One instance per segment: P0 = point[i] (layout location 0), P1 = point[i + 1] (layout location 1)
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)0);
         glEnableVertexAttribArray(0);
+        glVertexAttribDivisor(0, 1);
 
-        glBindVertexArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)sizeof(glm::vec3));
+        glEnableVertexAttribArray(1);
+        glVertexAttribDivisor(1, 1);
+
+        GLState::BindVertexArray(0);
 
         _setup = true;
     }
 
-    void Polyline::Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat)
+    void Polyline::_UploadPoints()
+    {
+        if (_points.size() > _capacity)
+        {
+            // Geometric growth keeps appends amortized O(1); the whole array is re-uploaded only on growth
+            _capacity = std::max<size_t>({_points.size(), _capacity * 2, 16});
+            GLState::BindBuffer(GL_ARRAY_BUFFER, _VBO);
+            glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(glm::vec3), nullptr, GL_DYNAMIC_DRAW);
+            _dirty_begin = 0;
+            _dirty_end = _points.size();
+        }
+
+        _dirty_end = std::min(_dirty_end, _points.size());
+        if (_dirty_begin < _dirty_end)
+        {
+            GLState::BindBuffer(GL_ARRAY_BUFFER, _VBO);
+            glBufferSubData(GL_ARRAY_BUFFER, _dirty_begin * sizeof(glm::vec3), (_dirty_end - _dirty_begin) * sizeof(glm::vec3), _points.data() + _dirty_begin);
+        }
+
+        _dirty_begin = _dirty_end = 0;
+    }
+
+    void Polyline::_MarkDirty(size_t begin, size_t end)
+    {
+        if (begin >= end)
+            return;
+
+        ExtendRange(_dirty_begin, _dirty_end, begin, end);
+        ExtendRange(_copy_begin, _copy_end, begin, end);
+    }
+
+    unsigned int Polyline::Upload()
     {
         if (!_setup)
             _SetupPolyline();
 
+        _UploadPoints();
+        return _VBO;
+    }
+
+    std::pair<size_t, size_t> Polyline::TakeCopyRange()
+    {
+        std::pair<size_t, size_t> range(_copy_begin, std::min(_copy_end, _points.size()));
+        _copy_begin = _copy_end = 0;
+        return range;
+    }
+
+    void Polyline::Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat)
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
         shader->Use();
-        shader->SetUniform("COLOR", _color);
-        shader->SetUniform("MODEL_MAT", this->GetModelMatrix());
         shader->SetUniform("VIEW_MAT", view_mat);
         shader->SetUniform("PERS_MAT", pers_mat);
+        shader->SetUniform("VIEWPORT", glm::vec2(viewport[2], viewport[3]));
+        shader->SetUniform("FADE", false);
+        shader->SetUniform("USE_LINE_BUFFER", false);
+
+        // The segments are screen-space quads, so they must be filled even in wireframe mode
+        GLenum polygon_mode = GLState::GetPolygonMode();
+        GLState::PolygonMode(GL_FILL);
 
-        glBindVertexArray(VAO);
-        glLineWidth(_line_size);
-        glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(_points.size()));
-        glLineWidth(1.0f);
-        glBindVertexArray(0);
+        Draw(*shader);
+
+        GLState::PolygonMode(polygon_mode);
     }
 
-    std::vector<glm::vec3> Polyline::GetPoints() const
+    void Polyline::Draw(Shader &shader)
     {
-        return _points;
+        Upload();
+
+        if (_points.size() < 2)
+            return;
+
+        shader.SetUniform("COLOR", _color);
+        shader.SetUniform("MODEL_MAT", this->GetModelMatrix());
+        shader.SetUniform("WIDTH", _line_size);
+
+        GLState::BindVertexArray(VAO);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(_points.size() - 1));
+    }
+
+    void Polyline::Submit(RenderQueue &queue, std::shared_ptr<Shader> shader)
+    {
+        queue.SubmitLine(shader, *this);
+    }
+
+    const AABB &Polyline::GetLocalBounds()
+    {
+        if (_bounds_dirty)
+        {
+            _bounds = AABB();
+            for (const glm::vec3 &point : _points)
+                _bounds.Expand(point);
+            _bounds_dirty = false;
+        }
+        return _bounds;
+    }
+
+    AABB Polyline::GetWorldBounds()
+    {
+        return GetLocalBounds().Transformed(GetModelMatrix());
     }
 
     bool Polyline::AddPoint(const glm::vec3 &point, int index)
@@ -65,13 +176,18 @@ namespace RA
         if (index < 0 || index > static_cast<int>(_points.size()))
         {
             _points.push_back(point);
+            _MarkDirty(_points.size() - 1, _points.size());
         }
         else
         {
+            // Everything after the insertion point shifts by one
             _points.insert(_points.begin() + index, point);
+            _MarkDirty(index, _points.size());
         }
 
-        _setup = false;
+        // A new point can only grow the box
+        _bounds.Expand(point);
+
         return true;
     }
 
@@ -81,16 +197,43 @@ namespace RA
             return false;
 
         _points.erase(_points.begin() + index);
+        _MarkDirty(index, _points.size());
+        _bounds_dirty = true;
 
-        _setup = false;
         return true;
     }
 
-    bool Polyline::SetPoints(const std::vector<glm::vec3> vec)
+    bool Polyline::SetPoint(int index, const glm::vec3 &point)
     {
+        if (index < 0 || index >= static_cast<int>(_points.size()))
+            return false;
+
+        _points[index] = point;
+        _MarkDirty(index, index + 1);
+        _bounds_dirty = true;
+
+        return true;
+    }
+
+    bool Polyline::SetPoints(const std::vector<glm::vec3> &vec)
+    {
+        // Assignment reuses the existing capacity, so a same-sized update does not allocate
         _points = vec;
 
-        _setup = false;
+        // The GPU buffer is kept if it is large enough
+        _MarkDirty(0, _points.size());
+        _bounds_dirty = true;
+
+        return true;
+    }
+
+    bool Polyline::SetPoints(std::vector<glm::vec3> &&vec)
+    {
+        _points = std::move(vec);
+
+        // The GPU buffer is kept if it is large enough
+        _MarkDirty(0, _points.size());
+        _bounds_dirty = true;
 
         return true;
     }
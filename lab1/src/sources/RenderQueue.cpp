@@ -0,0 +1,151 @@
+// Local Headers
+#include "RenderQueue.hpp"
+#include "GLState.hpp"
+#include "Polyline.hpp"
+#include "Profiler.hpp"
+#include "Renderable.hpp"
+// Standard Headers
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace RA
+{
+    void RenderQueue::Submit(const DrawPacket &packet)
+    {
+        if (!packet.Program || packet.Count <= 0)
+            return;
+
+        _packets.push_back(packet);
+        _current.Packets++;
+    }
+
+    void RenderQueue::SubmitLine(std::shared_ptr<Shader> shader, Polyline &line)
+    {
+        if (!shader || line.GetPoints().size() < 2)
+            return;
+
+        auto group = std::find_if(_lines.begin(), _lines.end(), [&](const LineGroup &g)
+                                  { return g.Program == shader; });
+
+        if (group == _lines.end())
+        {
+            _lines.push_back({shader, std::make_unique<LineBatch>()});
+            group = _lines.end() - 1;
+        }
+
+        // Only the pointer is queued; the batch copies the changed points from the polyline's buffer
+        group->Batch->Add(line);
+        _current.Packets++;
+    }
+
+    void RenderQueue::SubmitCustom(CustomDraw draw)
+    {
+        _custom.push_back({std::move(draw), nullptr, nullptr});
+        _current.Packets++;
+    }
+
+    void RenderQueue::SubmitRenderable(Renderable &renderable, std::shared_ptr<Shader> shader)
+    {
+        _custom.push_back({nullptr, &renderable, std::move(shader)});
+        _current.Packets++;
+    }
+
+    namespace
+    {
+        /// Calls of a GLState group that actually reached the driver.
+        uint64_t IssuedCalls(GLState::Counter counter)
+        {
+            const GLState::CallStats &stats = GLState::GetStats(counter);
+            return stats.Requested - stats.Skipped;
+        }
+    }
+
+    void RenderQueue::_UseProgram(Shader &shader, const glm::mat4 &view_mat, const glm::mat4 &pers_mat)
+    {
+        shader.Use();
+
+        // Uniforms persist per program, so the camera is uploaded once per frame
+        if (std::find(_cameraSet.begin(), _cameraSet.end(), shader.ID) == _cameraSet.end())
+        {
+            shader.SetUniform("VIEW_MAT", view_mat);
+            shader.SetUniform("PERS_MAT", pers_mat);
+            _cameraSet.push_back(shader.ID);
+        }
+    }
+
+    void RenderQueue::Flush(const glm::mat4 &view_mat, const glm::mat4 &pers_mat)
+    {
+        _cameraSet.clear();
+
+        // Redundant binds are skipped by GLState; the stats count the ones that were issued
+        uint64_t programs = IssuedCalls(GLState::PROGRAM);
+        uint64_t vaos = IssuedCalls(GLState::VERTEX_ARRAY);
+
+        std::stable_sort(_packets.begin(), _packets.end(), [](const DrawPacket &a, const DrawPacket &b)
+                         { return a.Program->ID != b.Program->ID ? a.Program->ID < b.Program->ID : a.VAO < b.VAO; });
+
+        {
+            RA_PROFILE_GPU("Mesh draw");
+            for (const DrawPacket &packet : _packets)
+            {
+                _UseProgram(*packet.Program, view_mat, pers_mat);
+                packet.Program->SetUniform("MODEL_MAT", packet.Model);
+                GLState::BindVertexArray(packet.VAO);
+
+                if (packet.Indexed)
+                    glDrawElements(packet.Mode, packet.Count, GL_UNSIGNED_INT, 0);
+                else
+                    glDrawArrays(packet.Mode, packet.First, packet.Count);
+                _current.DrawCalls++;
+            }
+        }
+
+        {
+            RA_PROFILE_GPU("Line draw");
+
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+
+            // The segments are screen-space quads, so they must be filled even in wireframe mode
+            GLenum polygon_mode = GLState::GetPolygonMode();
+            GLState::PolygonMode(GL_FILL);
+
+            for (LineGroup &group : _lines)
+            {
+                if (group.Batch->LineCount() == 0)
+                    continue;
+
+                _UseProgram(*group.Program, view_mat, pers_mat);
+                group.Program->SetUniform("VIEWPORT", glm::vec2(viewport[2], viewport[3]));
+                group.Program->SetUniform("FADE", false);
+
+                // Every line of the group in one instanced draw
+                group.Batch->Draw(*group.Program);
+                _current.DrawCalls++;
+                _current.MergedLines += group.Batch->LineCount();
+                group.Batch->Clear();
+            }
+
+            GLState::PolygonMode(polygon_mode);
+        }
+
+        for (CustomPacket &packet : _custom)
+        {
+            if (packet.Object)
+                packet.Object->Render(packet.Program, view_mat, pers_mat);
+            else
+                packet.Draw(view_mat, pers_mat);
+            _current.DrawCalls++;
+        }
+
+        _packets.clear();
+        _custom.clear();
+
+        _current.ProgramChanges = static_cast<int>(IssuedCalls(GLState::PROGRAM) - programs);
+        _current.VAOChanges = static_cast<int>(IssuedCalls(GLState::VERTEX_ARRAY) - vaos);
+
+        _stats = _current;
+        _current = RenderStats();
+    }
+}
\ No newline at end of file
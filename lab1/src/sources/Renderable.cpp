@@ -1,16 +1,23 @@
 // Local Headers
 #include "Renderable.hpp"
+#include "GLState.hpp"
+#include "RenderQueue.hpp"
 
 namespace RA
 {
     Renderable::Renderable()
     {
         glGenVertexArrays(1, &VAO);
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
     }
 
     Renderable::~Renderable()
     {
-        glDeleteVertexArrays(1, &VAO);
+        GLState::DeleteVertexArray(VAO);
+    }
+
+    void Renderable::Submit(RenderQueue &queue, std::shared_ptr<Shader> shader)
+    {
+        queue.SubmitRenderable(*this, std::move(shader));
     }
 }
\ No newline at end of file
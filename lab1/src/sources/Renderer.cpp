@@ -1,4 +1,5 @@
 #include "Renderer.hpp"
+#include "GLState.hpp"
 #include <iostream>
 
 Renderer::Renderer()
@@ -8,10 +9,10 @@ Renderer::Renderer()
 
 void Renderer::InitOpenGL()
 {
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    RA::GLState::SetCapability(GL_DEPTH_TEST, true);
+    RA::GLState::DepthFunc(GL_LESS);
 
-    glEnable(GL_CULL_FACE);
+    RA::GLState::SetCapability(GL_CULL_FACE, true);
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW);
 
@@ -26,5 +27,5 @@ void Renderer::Clear(float r, float g, float b, float a) const
 
 void Renderer::SetWireframe(bool enabled) const
 {
-    glPolygonMode(GL_FRONT_AND_BACK, enabled ? GL_LINE : GL_FILL);
+    RA::GLState::PolygonMode(enabled ? GL_LINE : GL_FILL);
 }
@@ -0,0 +1,170 @@
+// Local Headers
+#include "SceneBVH.hpp"
+// Standard Headers
+#include <algorithm>
+
+namespace RA
+{
+    namespace
+    {
+        constexpr int LEAF_SIZE = 4;
+        constexpr int STACK_SIZE = 64;
+    }
+
+    int SceneBVH::Add(const AABB &bounds)
+    {
+        _Bounds.push_back(bounds);
+        _NeedsBuild = true;
+        return static_cast<int>(_Bounds.size()) - 1;
+    }
+
+    void SceneBVH::Clear()
+    {
+        _Bounds.clear();
+        _Order.clear();
+        _Nodes.clear();
+        _NeedsBuild = false;
+        _NeedsRefit = false;
+    }
+
+    void SceneBVH::SetBounds(int item, const AABB &bounds)
+    {
+        _Bounds[item] = bounds;
+        _NeedsRefit = true;
+    }
+
+    void SceneBVH::Update()
+    {
+        if (_NeedsBuild)
+        {
+            _Order.resize(_Bounds.size());
+            for (size_t i = 0; i < _Order.size(); i++)
+                _Order[i] = static_cast<int>(i);
+
+            _Nodes.clear();
+            if (!_Bounds.empty())
+            {
+                _Nodes.reserve(2 * (_Bounds.size() / LEAF_SIZE + 1));
+                _Nodes.emplace_back();
+                _BuildNode(0, 0, static_cast<int>(_Bounds.size()));
+            }
+
+            _NeedsBuild = false;
+            _NeedsRefit = false;
+        }
+        else if (_NeedsRefit)
+        {
+            _Refit();
+            _NeedsRefit = false;
+        }
+    }
+
+    void SceneBVH::_BuildNode(int index, int first, int count)
+    {
+        AABB bounds;
+        AABB centroids;
+
+        for (int i = first; i < first + count; i++)
+        {
+            const AABB &item = _Bounds[_Order[i]];
+            bounds.Expand(item);
+            if (item.Valid())
+                centroids.Expand(item.Center());
+        }
+
+        _Nodes[index].Bounds = bounds;
+        _Nodes[index].First = first;
+        _Nodes[index].Count = count;
+        _Nodes[index].Left = -1;
+
+        if (count <= LEAF_SIZE)
+            return;
+
+        // Median split along the longest axis of the centroid bounds.
+        glm::vec3 extent = centroids.Valid() ? centroids.Max - centroids.Min : glm::vec3(0.0f);
+        int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        int half = count / 2;
+
+        std::nth_element(_Order.begin() + first, _Order.begin() + first + half, _Order.begin() + first + count,
+                         [this, axis](int a, int b)
+                         { return _Bounds[a].Min[axis] + _Bounds[a].Max[axis] < _Bounds[b].Min[axis] + _Bounds[b].Max[axis]; });
+
+        // Children are allocated as a pair, so only the first index is stored.
+        int left = static_cast<int>(_Nodes.size());
+        _Nodes.emplace_back();
+        _Nodes.emplace_back();
+        _Nodes[index].Left = left;
+
+        _BuildNode(left, first, half);
+        _BuildNode(left + 1, first + half, count - half);
+    }
+
+    void SceneBVH::_Refit()
+    {
+        for (int i = static_cast<int>(_Nodes.size()) - 1; i >= 0; i--)
+        {
+            Node &node = _Nodes[i];
+            node.Bounds = AABB();
+
+            if (node.Left < 0)
+            {
+                for (int j = node.First; j < node.First + node.Count; j++)
+                    node.Bounds.Expand(_Bounds[_Order[j]]);
+            }
+            else
+            {
+                node.Bounds.Expand(_Nodes[node.Left].Bounds);
+                node.Bounds.Expand(_Nodes[node.Left + 1].Bounds);
+            }
+        }
+    }
+
+    int SceneBVH::Cull(const Frustum &frustum, std::vector<uint8_t> &visible) const
+    {
+        visible.assign(_Bounds.size(), 0);
+        if (_Nodes.empty())
+            return 0;
+
+        int count = 0;
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0)
+        {
+            const Node &node = _Nodes[stack[--top]];
+
+            Frustum::Result result = frustum.Test(node.Bounds);
+            if (result == Frustum::OUTSIDE)
+                continue;
+
+            // Whole subtree inside: its items are contiguous in _Order
+            if (result == Frustum::INSIDE)
+            {
+                for (int i = node.First; i < node.First + node.Count; i++)
+                    visible[_Order[i]] = 1;
+                count += node.Count;
+                continue;
+            }
+
+            if (node.Left < 0)
+            {
+                for (int i = node.First; i < node.First + node.Count; i++)
+                {
+                    int item = _Order[i];
+                    if (frustum.Test(_Bounds[item]) != Frustum::OUTSIDE)
+                    {
+                        visible[item] = 1;
+                        count++;
+                    }
+                }
+                continue;
+            }
+
+            stack[top++] = node.Left;
+            stack[top++] = node.Left + 1;
+        }
+
+        return count;
+    }
+}
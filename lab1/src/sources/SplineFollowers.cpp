@@ -0,0 +1,41 @@
+#include "SplineFollowers.hpp"
+
+namespace RA
+{
+    namespace
+    {
+        /// Place a follower at a curve parameter, with no motion since the previous step.
+        void PlaceAt(SplineFollower &follower, float u)
+        {
+            u = std::max(u, 0.0f);
+            follower.Segment = static_cast<int>(u);
+            follower.T = u - follower.Segment;
+            follower.PreviousSegment = follower.Segment;
+            follower.PreviousT = follower.T;
+        }
+    }
+
+    size_t SplineFollowers::Add(float speed, float start)
+    {
+        SplineFollower follower;
+        follower.Speed = speed;
+        follower.Start = start;
+        PlaceAt(follower, start);
+
+        _followers.push_back(follower);
+        _positions.emplace_back(0.0f);
+        return _followers.size() - 1;
+    }
+
+    void SplineFollowers::Clear()
+    {
+        _followers.clear();
+        _positions.clear();
+    }
+
+    void SplineFollowers::Reset()
+    {
+        for (SplineFollower &follower : _followers)
+            PlaceAt(follower, follower.Start);
+    }
+}
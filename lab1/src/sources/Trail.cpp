@@ -0,0 +1,148 @@
+// Local Headers
+#include "Trail.hpp"
+#include "GLState.hpp"
+// Standard Headers
+#include <algorithm>
+#include <cstddef>
+
+namespace RA
+{
+    Trail::Trail(int capacity, float size, glm::vec4 color, float lifetime)
+        : Renderable(), _capacity(std::max(2, capacity)), _line_size(size), _color(color), _lifetime(lifetime)
+    {
+        _vertices.resize(_capacity + 1);
+
+        GLState::BindVertexArray(VAO);
+
+        glGenBuffers(1, &_VBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _VBO);
+        glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+
+        // One instance per segment, as in the 'polyline' shader: positions of two consecutive slots
+        // (layout locations 0 and 1) and their timestamps (layout locations 2 and 3); the pointers are set per draw
+        for (GLuint location : {0u, 1u, 2u, 3u})
+        {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+
+        GLState::BindVertexArray(0);
+    }
+
+    Trail::~Trail()
+    {
+        if (_VBO)
+            GLState::DeleteBuffer(_VBO);
+    }
+
+    void Trail::Push(const glm::vec3 &point, float time)
+    {
+        _vertices[_head] = {point, time};
+
+        // Slot 0 is mirrored past the end, so the oldest strip can run into it without a gap
+        if (_head == 0)
+            _vertices[_capacity] = _vertices[0];
+
+        _head = (_head + 1) % _capacity;
+        _count = std::min(_count + 1, _capacity);
+        _pending = std::min(_pending + 1, _capacity);
+    }
+
+    void Trail::Clear()
+    {
+        _head = 0;
+        _count = 0;
+        _pending = 0;
+    }
+
+    void Trail::_UploadRange(int first, int count)
+    {
+        if (count <= 0)
+            return;
+
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Vertex), count * sizeof(Vertex), _vertices.data() + first);
+
+        if (first == 0)
+            glBufferSubData(GL_ARRAY_BUFFER, _capacity * sizeof(Vertex), sizeof(Vertex), _vertices.data() + _capacity);
+    }
+
+    void Trail::_UploadPending()
+    {
+        if (_pending == 0)
+            return;
+
+        // The pending slots end at the head and may wrap around the end of the ring
+        int first = (_head - _pending + _capacity) % _capacity;
+        int tail = std::min(_pending, _capacity - first);
+
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _VBO);
+        _UploadRange(first, tail);
+        _UploadRange(0, _pending - tail);
+
+        _pending = 0;
+    }
+
+    void Trail::_DrawSegments(int first, int points)
+    {
+        if (points < 2)
+            return;
+
+        // GL 3.3 has no base instance, so the attributes are pointed at the first slot instead
+        size_t p0 = first * sizeof(Vertex);
+        size_t p1 = p0 + sizeof(Vertex);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(p0 + offsetof(Vertex, Position)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(p1 + offsetof(Vertex, Position)));
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(p0 + offsetof(Vertex, Time)));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(p1 + offsetof(Vertex, Time)));
+
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, points - 1);
+    }
+
+    void Trail::Render(std::shared_ptr<Shader> shader, glm::mat4 view_mat, glm::mat4 pers_mat)
+    {
+        if (_count < 2)
+            return;
+
+        _UploadPending();
+
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        shader->Use();
+        shader->SetUniform("COLOR", _color);
+        shader->SetUniform("MODEL_MAT", glm::mat4(1.0f));
+        shader->SetUniform("VIEW_MAT", view_mat);
+        shader->SetUniform("PERS_MAT", pers_mat);
+        shader->SetUniform("WIDTH", _line_size);
+        shader->SetUniform("VIEWPORT", glm::vec2(viewport[2], viewport[3]));
+        shader->SetUniform("FADE", true);
+        shader->SetUniform("USE_LINE_BUFFER", false);
+        shader->SetUniform("NOW", static_cast<float>(glfwGetTime()));
+        shader->SetUniform("LIFETIME", _lifetime);
+
+        GLState::SetCapability(GL_BLEND, true);
+        GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        // The segments are screen-space quads, so they must be filled even in wireframe mode
+        GLenum polygon_mode = GLState::GetPolygonMode();
+        GLState::PolygonMode(GL_FILL);
+
+        GLState::BindVertexArray(VAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, _VBO);
+
+        if (_count < _capacity)
+        {
+            _DrawSegments(0, _count);
+        }
+        else
+        {
+            // Oldest part [head, capacity] including the mirror of slot 0, then the newest part [0, head)
+            int oldest_end = _head == 0 ? _capacity : _capacity + 1;
+            _DrawSegments(_head, oldest_end - _head);
+            _DrawSegments(0, _head);
+        }
+
+        GLState::PolygonMode(polygon_mode);
+        GLState::SetCapability(GL_BLEND, false);
+    }
+}
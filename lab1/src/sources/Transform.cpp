@@ -3,24 +3,31 @@
 namespace RA
 {
     Transform::Transform()
-        : _position(0.0f), _front(0.0f, 0.0f, 1.0f), _up(0.0f, 1.0f, 0.0f), _right(1.0f, 0.0f, 0.0f),
-          _scale(1.0f), _dirty(true), _modelMatrix(1.0f)
+        : _position(0.0f), _rotation(1.0f, 0.0f, 0.0f, 0.0f), _scale(1.0f), _dirty(true),
+          _rotationsSinceNormalize(0), _modelMatrix(1.0f)
     {
     }
 
     void Transform::_RecalculateModelMatrix()
     {
-        glm::mat4 translation = glm::translate(glm::mat4(1.0f), _position);
-        glm::mat4 rotation(1.0f);
-        rotation[0] = glm::vec4(_right, 0.0f);
-        rotation[1] = glm::vec4(_up, 0.0f);
-        rotation[2] = glm::vec4(_front, 0.0f);
-        glm::mat4 scaling = glm::scale(glm::mat4(1.0f), _scale);
-
-        _modelMatrix = translation * rotation * scaling;
+        // translation * rotation * scaling, written directly into the columns
+        glm::mat3 rotation = glm::mat3_cast(_rotation);
+        _modelMatrix[0] = glm::vec4(rotation[0] * _scale.x, 0.0f);
+        _modelMatrix[1] = glm::vec4(rotation[1] * _scale.y, 0.0f);
+        _modelMatrix[2] = glm::vec4(rotation[2] * _scale.z, 0.0f);
+        _modelMatrix[3] = glm::vec4(_position, 1.0f);
         _dirty = false;
     }
 
+    void Transform::_Renormalize()
+    {
+        if (++_rotationsSinceNormalize < RENORMALIZE_INTERVAL)
+            return;
+
+        _rotation = glm::normalize(_rotation);
+        _rotationsSinceNormalize = 0;
+    }
+
     glm::mat4 Transform::GetModelMatrix()
     {
         if (_dirty)
@@ -28,12 +35,31 @@ namespace RA
         return _modelMatrix;
     }
 
+    glm::quat Transform::LookRotation(const glm::vec3 &front, const glm::vec3 &up)
+    {
+        glm::vec3 z = glm::normalize(front);
+        glm::vec3 x = glm::normalize(glm::cross(up, z));
+        glm::vec3 y = glm::cross(z, x);
+        return glm::normalize(glm::quat_cast(glm::mat3(x, y, z)));
+    }
+
+    glm::quat Transform::Nlerp(const glm::quat &from, const glm::quat &to, float t)
+    {
+        // q and -q are the same rotation; flip to take the shorter way
+        glm::quat target = glm::dot(from, to) < 0.0f ? -to : to;
+        return glm::normalize(from + (target - from) * t);
+    }
+
     // --- Movement & Rotation ---
     void Transform::Rotate(const glm::mat4 &rotation)
     {
-        _front = glm::normalize(glm::vec3(rotation * glm::vec4(_front, 0.0f)));
-        _up = glm::normalize(glm::vec3(rotation * glm::vec4(_up, 0.0f)));
-        _right = glm::normalize(glm::cross(_front, _up));
+        Rotate(glm::quat_cast(glm::mat3(rotation)));
+    }
+
+    void Transform::Rotate(const glm::quat &rotation)
+    {
+        _rotation = rotation * _rotation;
+        _Renormalize();
         _dirty = true;
     }
 
@@ -42,11 +68,11 @@ namespace RA
         x_offset *= sensitivity;
         y_offset *= sensitivity;
 
-        glm::mat4 yaw = glm::rotate(glm::mat4(1.0f), glm::radians(-x_offset), glm::vec3(0, 1, 0));
-        glm::vec3 new_front = glm::vec3(yaw * glm::vec4(_front, 0.0f));
-        glm::vec3 right = glm::normalize(glm::cross(new_front, glm::vec3(0, 1, 0)));
-        glm::mat4 pitch = glm::rotate(glm::mat4(1.0f), glm::radians(y_offset), right);
-        new_front = glm::vec3(pitch * glm::vec4(new_front, 0.0f));
+        const glm::vec3 world_up(0, 1, 0);
+
+        glm::vec3 new_front = glm::angleAxis(glm::radians(-x_offset), world_up) * GetFront();
+        glm::vec3 right = glm::normalize(glm::cross(new_front, world_up));
+        new_front = glm::angleAxis(glm::radians(y_offset), right) * new_front;
 
         if (constrain_pitch)
         {
@@ -55,10 +81,9 @@ namespace RA
                 return;
         }
 
-        _front = glm::normalize(new_front);
-        _right = glm::normalize(glm::cross(_front, glm::vec3(0, 1, 0)));
-        _up = glm::normalize(glm::cross(_right, _front));
-
+        // Rebuilt from the world up, so no roll creeps in
+        _rotation = LookRotation(new_front, world_up);
+        _rotationsSinceNormalize = 0;
         _dirty = true;
     }
 
@@ -69,7 +94,7 @@ namespace RA
     }
     void Transform::MoveL(const glm::vec3 &delta)
     {
-        _position += _right * delta.x + _up * delta.y - _front * delta.z;
+        _position += GetRight() * delta.x + GetUp() * delta.y - GetFront() * delta.z;
         _dirty = true;
     }
     void Transform::SetPosition(const glm::vec3 &position)
@@ -79,16 +104,20 @@ namespace RA
     }
     void Transform::SetOrientation(const glm::vec3 &front, const glm::vec3 &up)
     {
-        _front = glm::normalize(front);
-        _right = glm::normalize(glm::cross(_front, up));
-        _up = glm::normalize(glm::cross(_right, _front));
+        _rotation = LookRotation(front, up);
+        _rotationsSinceNormalize = 0;
         _dirty = true;
     }
     void Transform::SetOrientation(const glm::vec3 &front, const glm::vec3 &up, const glm::vec3 &right)
     {
-        _front = glm::normalize(front);
-        _right = glm::normalize(right);
-        _up = glm::normalize(up);
+        // A rotation is fully defined by front and up; right is implied (front x up)
+        (void)right;
+        SetOrientation(front, up);
+    }
+    void Transform::SetRotation(const glm::quat &rotation)
+    {
+        _rotation = glm::normalize(rotation);
+        _rotationsSinceNormalize = 0;
         _dirty = true;
     }
     void Transform::SetScale(const glm::vec3 &scale)
@@ -96,4 +125,18 @@ namespace RA
         _scale = scale;
         _dirty = true;
     }
-}
\ No newline at end of file
+    void Transform::SetWorldMatrix(const glm::mat4 &matrix)
+    {
+        _scale = glm::vec3(glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2])));
+        if (_scale.x > 0.0f && _scale.y > 0.0f && _scale.z > 0.0f)
+        {
+            glm::mat3 rotation(glm::vec3(matrix[0]) / _scale.x, glm::vec3(matrix[1]) / _scale.y, glm::vec3(matrix[2]) / _scale.z);
+            _rotation = glm::normalize(glm::quat_cast(rotation));
+            _rotationsSinceNormalize = 0;
+        }
+        _position = glm::vec3(matrix[3]);
+
+        _modelMatrix = matrix;
+        _dirty = false;
+    }
+}
@@ -0,0 +1,137 @@
+#include "TransformHierarchy.hpp"
+#include "Transform.hpp"
+
+// Standard Headers
+#include <atomic>
+
+namespace RA
+{
+    namespace
+    {
+        /// Local TRS matrix written column by column, no matrix products.
+        glm::mat4 ComposeLocal(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+        {
+            glm::mat3 basis = glm::mat3_cast(rotation);
+            return glm::mat4(glm::vec4(basis[0] * scale.x, 0.0f),
+                             glm::vec4(basis[1] * scale.y, 0.0f),
+                             glm::vec4(basis[2] * scale.z, 0.0f),
+                             glm::vec4(position, 1.0f));
+        }
+
+        /// parent * local for affine matrices: the last row of local is (0, 0, 0, 1), so each
+        /// column is three multiply-adds of whole columns (plus the parent translation for the last one).
+        glm::mat4 ComposeAffine(const glm::mat4 &parent, const glm::mat4 &local)
+        {
+            glm::mat4 result;
+            for (int c = 0; c < 4; c++)
+                result[c] = parent[0] * local[c].x + parent[1] * local[c].y + parent[2] * local[c].z;
+            result[3] += parent[3];
+            return result;
+        }
+    }
+
+    TransformHierarchy::Node TransformHierarchy::Create(Node parent)
+    {
+        if (parent >= static_cast<Node>(Size()))
+            parent = NONE;
+
+        Node node = static_cast<Node>(Size());
+        _parent.push_back(parent);
+        _position.emplace_back(0.0f);
+        _rotation.emplace_back(1.0f, 0.0f, 0.0f, 0.0f);
+        _scale.emplace_back(1.0f);
+        _world.emplace_back(1.0f);
+        _dirty.push_back(1);
+        _changed.push_back(0);
+
+        // Depth is one more than the parent's level
+        size_t depth = parent == NONE ? 0 : _depth[parent] + 1;
+        _depth.push_back(static_cast<int>(depth));
+        if (depth >= _levels.size())
+            _levels.resize(depth + 1);
+        _levels[depth].push_back(node);
+
+        return node;
+    }
+
+    void TransformHierarchy::Clear()
+    {
+        _parent.clear();
+        _position.clear();
+        _rotation.clear();
+        _scale.clear();
+        _world.clear();
+        _dirty.clear();
+        _changed.clear();
+        _depth.clear();
+        _levels.clear();
+    }
+
+    void TransformHierarchy::SetPosition(Node node, const glm::vec3 &position)
+    {
+        _position[node] = position;
+        _dirty[node] = 1;
+    }
+
+    void TransformHierarchy::SetOrientation(Node node, const glm::vec3 &front, const glm::vec3 &up)
+    {
+        _rotation[node] = Transform::LookRotation(front, up);
+        _dirty[node] = 1;
+    }
+
+    void TransformHierarchy::SetRotation(Node node, const glm::quat &rotation)
+    {
+        _rotation[node] = glm::normalize(rotation);
+        _dirty[node] = 1;
+    }
+
+    void TransformHierarchy::SetScale(Node node, const glm::vec3 &scale)
+    {
+        _scale[node] = scale;
+        _dirty[node] = 1;
+    }
+
+    bool TransformHierarchy::_UpdateNode(Node node)
+    {
+        Node parent = _parent[node];
+        bool parent_changed = parent != NONE && _changed[parent];
+
+        if (!_dirty[node] && !parent_changed)
+        {
+            _changed[node] = 0;
+            return false;
+        }
+
+        glm::mat4 local = ComposeLocal(_position[node], _rotation[node], _scale[node]);
+        _world[node] = parent == NONE ? local : ComposeAffine(_world[parent], local);
+        _dirty[node] = 0;
+        _changed[node] = 1;
+        return true;
+    }
+
+    size_t TransformHierarchy::Update(JobSystem *jobs)
+    {
+        size_t updated = 0;
+
+        // Index order is already parent-first, and the contiguous sweep is the fastest serial order
+        if (!jobs || Size() <= BATCH)
+        {
+            for (Node node = 0; node < static_cast<Node>(Size()); node++)
+                updated += _UpdateNode(node);
+            return updated;
+        }
+
+        // Level by level: a level only reads world matrices of the level above
+        std::atomic<size_t> counter{0};
+        for (const std::vector<Node> &level : _levels)
+        {
+            jobs->ParallelFor(level.size(), BATCH, [&](size_t begin, size_t end)
+                              {
+                                  size_t local = 0;
+                                  for (size_t i = begin; i < end; i++)
+                                      local += _UpdateNode(level[i]);
+                                  counter.fetch_add(local, std::memory_order_relaxed); });
+        }
+        return counter.load();
+    }
+}
@@ -1,4 +1,5 @@
 #include "Window.hpp"
+#include "ProgramCache.hpp"
 
 Window::Window(int width, int height, const std::string &title)
 {
@@ -29,6 +30,9 @@ Window::Window(int width, int height, const std::string &title)
         exit(1);
     }
 
+    // Program binaries are loaded through the same loader; lab1's GLAD has no entry points for them.
+    RA::ProgramCache::Initialize((GLADloadproc)glfwGetProcAddress);
+
     std::cout << "[DEBUG]: OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
 }
 
@@ -38,6 +42,16 @@ Window::~Window()
     glfwTerminate();
 }
 
+void Window::SetTitle(const std::string &title) const
+{
+    SetTitle(title.c_str());
+}
+
+void Window::SetTitle(const char *title) const
+{
+    glfwSetWindowTitle(_Window, title);
+}
+
 bool Window::ShouldClose() const
 {
     return glfwWindowShouldClose(_Window);
@@ -2,11 +2,17 @@
 
 // Local
 #include "Camera.hpp"
+#include "FixedTimestep.hpp"
+#include "JobSystem.hpp"
+#include "ParticleRenderer.hpp"
 #include "ParticleSystem.hpp"
+#include "RenderTarget.hpp"
+#include "TextureArray.hpp"
 #include "Window.hpp"
 // Standard
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace RA
@@ -24,10 +30,28 @@ namespace RA
         extern std::shared_ptr<RA::ParticleSystem> StarsPS;
         extern std::shared_ptr<RA::ParticleSystem> SnowPS;
 
+        /// Worker threads, decoding the particle images while the rest starts up.
+        extern std::shared_ptr<RA::JobSystem> Jobs;
+
+        /// The images of all particle systems, packed into one array texture and uploaded over the first frames.
+        extern std::shared_ptr<RA::TextureArray> Images;
+
+        /// Draws all particle systems together, sorted back to front.
+        extern std::shared_ptr<RA::ParticleRenderer> Particles;
+
+        /// The frame is rendered here, so the particles can read the scene depth, and then blitted to the window.
+        extern std::shared_ptr<RA::RenderTarget> SceneTarget;
+
         /// Window component of the Application.
         extern std::shared_ptr<RA::Window> Window;
 
         /// Camera component of the Application.
         extern std::shared_ptr<RA::Camera> Camera;
+
+        /// Simulation clock: particles are updated at 120 Hz, with at most 8 catch-up steps per frame.
+        extern RA::FixedTimestep Timestep;
+
+        /// Chrome trace written at exit, profiling is off when empty.
+        extern std::string TraceFile;
     };
 };
\ No newline at end of file
@@ -15,6 +15,11 @@ namespace RA
         extern std::shared_ptr<RA::ComputeShader> BirthCompute;
         extern std::shared_ptr<RA::ComputeShader> LifeCompute;
         extern std::shared_ptr<RA::ComputeShader> DeadResetCompute;
+        extern std::shared_ptr<RA::ComputeShader> CullCompute;
+        extern std::shared_ptr<RA::ComputeShader> RadixHistogramCompute;
+        extern std::shared_ptr<RA::ComputeShader> RadixScanCompute;
+        extern std::shared_ptr<RA::ComputeShader> RadixScatterCompute;
         extern std::shared_ptr<RA::RenderShader> Render;
+        extern std::shared_ptr<RA::RenderShader> Composite;
     };
 };
\ No newline at end of file
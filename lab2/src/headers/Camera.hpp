@@ -3,6 +3,7 @@
 // Local
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace RA
 {
@@ -13,9 +14,9 @@ namespace RA
 
         glm::mat4 GetViewMatrix();
         glm::vec3 GetPosition() const { return _position; }
-        glm::vec3 GetFront() const { return _front; }
-        glm::vec3 GetUp() const { return _up; }
-        glm::vec3 GetRight() const { return right; }
+        glm::vec3 GetFront() const { return _orientation * glm::vec3(0.f, 0.f, -1.f); }
+        glm::vec3 GetUp() const { return _orientation * glm::vec3(0.f, 1.f, 0.f); }
+        glm::vec3 GetRight() const { return _orientation * glm::vec3(1.f, 0.f, 0.f); }
 
         void Move(const glm::vec3 &deltaWorld);
         void MoveLocal(const glm::vec3 &deltaLocal);
@@ -25,16 +26,15 @@ namespace RA
         void SetPosition(const glm::vec3 &p);
         void SetOrientation(const glm::vec3 &newFront, const glm::vec3 &worldUp = glm::vec3(0, 1, 0));
 
-    private:
-        void RecalculateVectors();
+        /// Incremental rotations between two renormalizations of the orientation.
+        static constexpr int RENORMALIZE_INTERVAL = 16;
 
+    private:
         glm::vec3 _position;
-        glm::vec3 _front;
-        glm::vec3 _up;
-        glm::vec3 right;
+        glm::quat _orientation; // Rotates the view space axes (-Z forward, +Y up) into world space.
 
-        float _yaw;
-        float _pitch;
+        float _pitch;          // Kept only to limit the pitch.
+        int _rotationsSinceNormalize;
 
         bool _dirty;
         glm::mat4 _view;
@@ -34,7 +34,7 @@ namespace RA
         /// @brief Destructor – deletes the OpenGL shader program.
         ~ComputeShader();
 
-        /// @brief Activate (use) this shader program.
+        /// @brief Activate (use) this shader program; the first use waits for it to be compiled and linked.
         void Use();
 
         /// @brief Set a boolean uniform.
@@ -59,7 +59,7 @@ namespace RA
         void SetUniform(const std::string &name, const glm::vec3 &vec) const;
 
     private:
-        /// @brief Check for shader compiler or program linking errors.
-        void _CheckCompilerErrors(unsigned int shader, std::string type);
+        /// @brief Has the program been resolved with ProgramCache::Finish.
+        bool _finished = false;
     };
 }
\ No newline at end of file
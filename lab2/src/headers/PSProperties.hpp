@@ -41,5 +41,17 @@ namespace RA
 
         /// @brief Does gravity affect the particles?
         bool Gravity = true;
+
+        /// @brief Particles smaller than this many pixels on screen are culled before drawing.
+        float MinimumPixelSize = 0.5f;
+
+        /// @brief With soft particles, particles fade out over this view distance in front of the scene.
+        float SoftDistance = 1.0f;
+
+        /// @brief Draw in the low resolution pass, for large and soft particles whose fill rate dominates.
+        bool LowResolution = false;
+
+        /// @brief How many times a flipbook sprite plays its frames over the life of a particle.
+        float FlipbookLoops = 1.0f;
     };
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+// Local
+#include "ParticleSorter.hpp"
+#include "ParticleSystem.hpp"
+#include "RenderTarget.hpp"
+#include "TextureArray.hpp"
+// Standard
+#include <memory>
+#include <vector>
+// External
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    class Camera;
+    class Window;
+
+    /**
+     * @brief Draws several particle systems together, back to front.
+     *
+     * Every frame each system is culled into one shared list (cull.compute), which holds the
+     * drawn position of the survivors and a view depth key. The list is radix sorted on the GPU
+     * and drawn with a single indirect draw, so transparent particles blend in the right order
+     * across systems, whatever order the systems were created in. All images come from one
+     * TextureArray, so systems with different sprites still share the draw.
+     *
+     * When the scene is rendered into a RenderTarget, its depth is copied into a texture the particles
+     * read: fragments behind the scene are discarded and, with SoftParticles, particles fade out where
+     * they come close to it. Systems with Properties.LowResolution are drawn in a second pass into a
+     * smaller target, which is upsampled with depth-aware (bilateral) weights and composited over the scene.
+     */
+    class ParticleRenderer
+    {
+    public:
+        /// @brief Allocates the shared particle list, the sort buffers and the quad on the graphics device.
+        /// @param systems The particle systems to draw.
+        /// @param images The built array holding the sprites of the systems, may be null.
+        ParticleRenderer(const std::vector<std::shared_ptr<ParticleSystem>> &systems,
+                         std::shared_ptr<TextureArray> images = nullptr);
+
+        /// @brief Deallocates all resources on the graphics device.
+        ~ParticleRenderer();
+
+        ParticleRenderer(const ParticleRenderer &) = delete;
+        ParticleRenderer &operator=(const ParticleRenderer &) = delete;
+
+        /// @brief Culls, sorts and renders all particle systems onto the bound framebuffer.
+        /// @param cam Pointer to the application's Camera object.
+        /// @param win Pointer to the application's Window object.
+        /// @param time_ahead Time since the last update; particles are drawn moved along their velocity by it.
+        /// @param scene The bound target holding the scene depth. Without it (or without its depth texture)
+        /// there are no soft particles and all systems are drawn at full resolution.
+        void Render(std::shared_ptr<Camera> cam, std::shared_ptr<Window> win, float time_ahead = 0.0f,
+                    const RenderTarget *scene = nullptr);
+
+        /// @brief The combined capacity of the drawn particle systems.
+        inline unsigned int GetMaxParticles() const { return n_max_particles_; }
+
+        /// @brief Sort the particles back to front before drawing; otherwise they are drawn in culling order.
+        bool Sorted = true;
+
+        /// @brief Fade particles out near the scene depth over their system's Properties.SoftDistance.
+        bool SoftParticles = false;
+
+        /// @brief The low resolution pass renders at the scene size divided by this (2 or 4 are sensible).
+        unsigned int LowResolutionDivisor = 2;
+
+    private:
+        /// @brief Per system settings as read by render.vert (std430 layout).
+        struct SystemData
+        {
+            glm::vec4 StartColor;
+            glm::vec4 EndColor;
+            int FirstLayer;
+            int FrameCount;
+            float FrameLoops;
+            float SoftDistance;
+        };
+
+        /// @brief Which systems a pass culls and draws.
+        enum class Pass
+        {
+            All,
+            FullResolution,
+            LowResolution
+        };
+
+        /// @brief The drawn particle systems.
+        std::vector<std::shared_ptr<ParticleSystem>> systems_;
+        /// @brief The sprites of all systems.
+        std::shared_ptr<TextureArray> images_;
+        /// @brief Holds the combined capacity of the systems.
+        unsigned int n_max_particles_;
+
+        /// @brief Sorts the survivors by view depth.
+        ParticleSorter sorter_;
+
+        /// @brief Handle for the SSBO of surviving particles, shared by all systems.
+        GLuint m_ssbo_render_particles_ = 0;
+        /// @brief Handle for the SSBO of per system settings.
+        GLuint m_ssbo_systems_ = 0;
+        /// @brief Handle for the indirect draw command; the culling pass counts the instances.
+        GLuint m_indirect_ = 0;
+        /// @brief Handle for the rendering VAO.
+        GLuint m_vao_ = 0;
+        /// @brief Handle for the rendering VBO.
+        GLuint m_vbo_ = 0;
+
+        /// @brief Copy of the scene depth; the scene target keeps its own attached for the depth test.
+        GLuint m_scene_depth_ = 0;
+        /// @brief Size of the scene depth copy.
+        glm::ivec2 scene_depth_size_ = glm::ivec2(0);
+        /// @brief Premultiplied color of the low resolution systems.
+        RenderTarget low_resolution_;
+
+        /// @brief Initializes the shared particle list, the system settings and the indirect command.
+        void InitializeBuffers_();
+
+        /// @brief Initializes the rendering buffers.
+        void InitializeRendering_();
+
+        /// @brief Runs the culling pass of every system: live particles inside the frustum and not smaller than
+        /// their system's Properties.MinimumPixelSize are appended to the shared list with their sort keys.
+        /// @return True if any system belongs to the pass.
+        bool Cull_(Camera &cam, Window &win, float time_ahead, Pass pass, glm::ivec2 target_size);
+
+        /// @brief Sorts the culled particles and draws them onto the bound framebuffer.
+        /// @param scene_depth Read the scene depth copy to discard hidden fragments (and to fade, with SoftParticles).
+        /// @param target_size Size of the bound framebuffer; the scene depth is scaled onto it.
+        void Draw_(Camera &cam, Window &win, bool scene_depth, glm::ivec2 target_size, bool premultiplied);
+
+        /// @brief Copies the depth of the scene into m_scene_depth_, reallocated when the size changes.
+        void CopySceneDepth_(const RenderTarget &scene);
+
+        /// @brief Upsamples the low resolution pass onto the bound scene target.
+        void Composite_(Window &win);
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+// Standard
+#include <iostream>
+// External
+#include <glad/glad.h>
+
+namespace RA
+{
+    /**
+     * @brief GPU radix sort of (key, value) pairs of 32-bit unsigned integers.
+     *
+     * Every pass sorts by one 8-bit digit with three compute shaders: a per-tile digit histogram,
+     * a prefix sum over all tiles and a scatter that sorts each tile in shared memory first, so the
+     * writes of a tile stay contiguous. The number of keys is read from a GPU buffer and the number
+     * of tiles from a dispatch-indirect buffer, so both can come straight from a compute pass without
+     * a read-back, and the cost of a sort follows the keys actually written instead of the capacity.
+     */
+    class ParticleSorter
+    {
+    public:
+        /// @brief Pairs sorted by one work group of the histogram and scatter passes.
+        static constexpr unsigned int TILE = 2048;
+
+        /// @brief Allocates the key, value and histogram buffers on the graphics device.
+        /// @param max_keys The maximum number of pairs sorted at once.
+        ParticleSorter(unsigned int max_keys);
+
+        /// @brief Deallocates all resources on the graphics device.
+        ~ParticleSorter();
+
+        ParticleSorter(const ParticleSorter &) = delete;
+        ParticleSorter &operator=(const ParticleSorter &) = delete;
+
+        /// @brief Buffer to write the keys to sort into (GetMaxKeys() uints).
+        inline GLuint GetKeyBuffer() const { return m_keys_[0]; }
+
+        /// @brief Buffer to write the values to sort into (GetMaxKeys() uints).
+        inline GLuint GetValueBuffer() const { return m_values_[0]; }
+
+        /// @brief Dispatch-indirect buffer (num_groups_x, 1, 1) of the histogram and scatter passes; the
+        /// pass writing the keys stores the number of tiles, ceil(count / TILE), in its first uint.
+        inline GLuint GetDispatchBuffer() const { return m_dispatch_; }
+
+        /// @brief Sets the number of tiles the next Sort processes, 0 before a pass that counts them on the GPU.
+        void ResetDispatch(unsigned int tiles = 0);
+
+        /// @brief Buffer holding the keys in ascending order after the last Sort.
+        inline GLuint GetSortedKeys() const { return m_keys_[n_result_]; }
+
+        /// @brief Buffer holding the values ordered by their keys after the last Sort.
+        inline GLuint GetSortedValues() const { return m_values_[n_result_]; }
+
+        /// @brief The maximum number of pairs sorted at once.
+        inline unsigned int GetMaxKeys() const { return n_max_keys_; }
+
+        /// @brief Sorts the pairs in the key and value buffers, ascending and stable.
+        /// @param count_buffer Buffer holding the number of pairs, written on the GPU.
+        /// @param count_index Index of the count among the uints of count_buffer.
+        /// The number of tiles must be in the dispatch buffer (see GetDispatchBuffer).
+        /// @param key_bits Number of low key bits to sort by (one pass per 8 bits).
+        /// @return If the sort could run (the sort shaders are loaded).
+        bool Sort(GLuint count_buffer, unsigned int count_index, unsigned int key_bits = 32);
+
+        /// @brief Prints the GPU time of sorting random keys with 16-bit and 32-bit keys and checks the result.
+        /// @param count Number of pairs.
+        /// @param iterations Number of timed sorts per key size.
+        static void Benchmark(unsigned int count, int iterations);
+
+    private:
+        /// @brief Holds the maximum number of pairs.
+        unsigned int n_max_keys_;
+        /// @brief Holds the number of tiles (TILE pairs each) the buffers are sized for.
+        unsigned int n_groups_;
+        /// @brief Which of the two buffers holds the sorted pairs.
+        unsigned int n_result_ = 0;
+
+        /// @brief Handles for the key buffers, used alternately as pass input and output.
+        GLuint m_keys_[2] = {0, 0};
+        /// @brief Handles for the value buffers, used alternately as pass input and output.
+        GLuint m_values_[2] = {0, 0};
+        /// @brief Handle for the digit histogram of all tiles.
+        GLuint m_histogram_ = 0;
+        /// @brief Handle for the dispatch size of the histogram and scatter passes.
+        GLuint m_dispatch_ = 0;
+    };
+}
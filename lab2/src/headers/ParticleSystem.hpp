@@ -3,6 +3,7 @@
 // Local
 #include "Assets.hpp"
 #include "PSProperties.hpp"
+#include "TextureArray.hpp"
 // Standard
 #include <iostream>
 #include <memory>
@@ -13,9 +14,6 @@
 
 namespace RA
 {
-    class Camera;
-    class Window;
-
     /// Class which represents a particle system, completely ready to manipulate and render.
     class ParticleSystem
     {
@@ -32,19 +30,19 @@ namespace RA
         /// @param dt The time passed since last frame/last call of the update function.
         void Update(float dt);
 
-        /// @brief Renders the particle system onto the screen.
-        /// @param cam Pointer to the application's Camera object.
-        /// @param win Pointer to the application's Window object.
-        void Render(std::shared_ptr<Camera> cam, std::shared_ptr<Window> win);
-
         /// @brief The limit of particles count in this system.
         /// @return Unsigned integer representing the maximum particles that can exist inside this system.
         inline unsigned int GetMaxParticles() const { return n_max_particles_; }
 
-        /// @brief Loads an image texture using stb_image library as a texture to use for the particles.
-        /// @param path The path to the image file.
-        /// @return If the operation was sucessful or not.
-        bool LoadTexture(const std::string &path);
+        /// @brief Handle for the particle SSBO, read by the ParticleRenderer.
+        inline GLuint GetParticleBuffer() const { return m_ssbo_particles_; }
+
+        /// @brief The layers of the shared TextureArray drawn on the particles, invalid if none.
+        inline const Sprite &GetSprite() const { return sprite_; }
+
+        /// @brief Sets the image drawn on the particles; a flipbook plays its frames over each particle's life.
+        /// @param sprite Layers returned by TextureArray::Add for the array the ParticleRenderer samples.
+        inline void SetSprite(const Sprite &sprite) { sprite_ = sprite; }
 
         /// @brief Structure which holds all the editable properties of the particle system.
         PSProperties Properties;
@@ -59,23 +57,13 @@ namespace RA
         GLuint m_ssbo_particles_ = 0;
         /// @brief Handle for the deadlist SSBO.
         GLuint m_ssbo_deadlist_ = 0;
-        /// @brief Handle for the rendering VAO.
-        GLuint m_vao_ = 0;
-        /// @brief Handle for the rendering VBO.
-        GLuint m_vbo_ = 0;
-        /// @brief Handle for the texture of an image to render on each particle quad.
-        GLuint m_image = 0;
+        /// @brief The layers of the image to render on each particle quad.
+        Sprite sprite_;
 
         /// @brief Helper variable to be able to spawn particles per frequency.
         float spawn_frequency_accumulator_ = 0.0f;
 
         /// @brief Initializes the SSBOs.
         void InitializeBuffers_();
-
-        /// @brief Initializes the rendering buffers.
-        void InitializeRendering_();
-
-        /// @brief Binds particle SSBO in order to achieve instanced rendering.
-        void BindForRendering_();
     };
 }
\ No newline at end of file
@@ -37,7 +37,7 @@ namespace RA
 		/// @brief Destructor – deletes the OpenGL shader program.
 		~RenderShader();
 
-		/// @brief Activate (use) this shader program.
+		/// @brief Activate (use) this shader program; the first use waits for it to be compiled and linked.
 		void Use();
 
 		/// @brief Set a boolean uniform.
@@ -58,14 +58,17 @@ namespace RA
 		/// @brief Set a 3D vector uniform.
 		void SetUniform(const std::string &name, const glm::vec3 &vec) const;
 
+		/// @brief Set a 2D vector uniform.
+		void SetUniform(const std::string &name, const glm::vec2 &vec) const;
+
 		/// @brief Returns true if this shader includes a geometry stage.
 		bool HasGeometry() const { return _geometry; };
 
 	private:
-		/// @brief Check for shader compiler or program linking errors.
-		void _CheckCompilerErrors(unsigned int shader, std::string type);
-
 		/// @brief Tracks whether this shader includes a geometry shader.
 		bool _geometry;
+
+		/// @brief Has the program been resolved with ProgramCache::Finish.
+		bool _finished = false;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+// Standard
+#include <iostream>
+// External
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace RA
+{
+    /**
+     * @brief An offscreen framebuffer with a color texture and an optional depth texture.
+     *
+     * Both attachments are textures, so later passes can sample what was rendered into them,
+     * e.g. the scene depth for soft particles or a low resolution particle layer for compositing.
+     */
+    class RenderTarget
+    {
+    public:
+        /// @brief Creates the framebuffer; the attachments are allocated by the first Resize.
+        /// @param color_format Sized internal format of the color texture.
+        /// @param depth Attach a 24 bit depth texture.
+        RenderTarget(GLenum color_format = GL_RGBA8, bool depth = true);
+
+        /// @brief Deallocates the framebuffer and its textures.
+        ~RenderTarget();
+
+        RenderTarget(const RenderTarget &) = delete;
+        RenderTarget &operator=(const RenderTarget &) = delete;
+
+        /// @brief Reallocates the attachments when the size changes; sizes are clamped to at least 1x1.
+        /// @return True if the framebuffer is complete.
+        bool Resize(glm::ivec2 size);
+
+        /// @brief Binds the framebuffer for drawing and sets the viewport to its size.
+        void Bind() const;
+
+        /// @brief Copies the color attachment onto the default framebuffer, scaled to the given size.
+        void BlitToScreen(glm::ivec2 screen_size) const;
+
+        /// @brief Binds the default framebuffer and sets the viewport to the given size.
+        static void BindScreen(glm::ivec2 screen_size);
+
+        inline GLuint GetFramebuffer() const { return m_fbo_; }
+        inline GLuint GetColorTexture() const { return m_color_; }
+        inline GLuint GetDepthTexture() const { return m_depth_; }
+        inline GLenum GetColorFormat() const { return color_format_; }
+        inline glm::ivec2 GetSize() const { return size_; }
+
+    private:
+        /// @brief Sized internal format of the color texture.
+        GLenum color_format_;
+        /// @brief Size of both attachments in pixels, zero until the first Resize.
+        glm::ivec2 size_ = glm::ivec2(0);
+
+        /// @brief Handle for the framebuffer object.
+        GLuint m_fbo_ = 0;
+        /// @brief Handle for the color texture.
+        GLuint m_color_ = 0;
+        /// @brief Handle for the depth texture, 0 without depth.
+        GLuint m_depth_ = 0;
+    };
+};
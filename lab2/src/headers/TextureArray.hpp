@@ -0,0 +1,148 @@
+#pragma once
+
+// Local
+#include "JobSystem.hpp"
+// Standard
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+// External
+#include <glad/glad.h>
+
+namespace RA
+{
+    /// @brief A run of layers in a TextureArray: one image, or the frames of a flipbook sheet.
+    struct Sprite
+    {
+        /// @brief The first layer, -1 if the image could not be loaded.
+        int FirstLayer = -1;
+
+        /// @brief The number of consecutive layers, one per flipbook frame.
+        int FrameCount = 0;
+
+        /// @brief True if the sprite has at least one layer.
+        inline bool Valid() const { return FirstLayer >= 0 && FrameCount > 0; }
+    };
+
+    /**
+     * @brief Packs the particle images into the layers of one GL_TEXTURE_2D_ARRAY.
+     *
+     * Add reserves the layers of an image right away and decodes it on the JobSystem workers:
+     * the PNG is decoded with stb_image, every frame is resampled to the layer size and its mip
+     * chain is built on the CPU. The result is written to a disk cache in that GPU-ready form
+     * (raw RGBA8, all mip levels), so later launches read it back without decoding the PNG.
+     *
+     * Build allocates the texture, cleared to transparent. Update, called once per frame, then
+     * uploads finished layers through a small ring of pixel buffer objects, at most a byte
+     * budget per frame, so loading never stalls a frame for long.
+     */
+    class TextureArray
+    {
+    public:
+        /// @brief Creates an empty array; nothing is allocated on the graphics device before Build.
+        /// @param layer_size Width and height of every layer in pixels.
+        /// @param jobs Workers decoding the images; without them Add decodes on the calling thread.
+        /// @param cache_directory Where decoded images are cached, caching is off when empty.
+        TextureArray(int layer_size = 256, JobSystem *jobs = nullptr, const std::string &cache_directory = "cache/textures");
+
+        /// @brief Waits for the decoding jobs and deallocates the texture and the pixel buffers.
+        ~TextureArray();
+
+        TextureArray(const TextureArray &) = delete;
+        TextureArray &operator=(const TextureArray &) = delete;
+
+        /// @brief Reserves layers for an image and queues its decoding.
+        /// @param path The path to the image file.
+        /// @param columns Frames per row of a flipbook sheet.
+        /// @param rows Rows of a flipbook sheet; frames are numbered row by row from the top left.
+        /// @return The layers of the image, invalid if the file does not exist. Images that fail to
+        /// decode later keep their layers and are drawn white, like particles without an image.
+        Sprite Add(const std::string &path, int columns = 1, int rows = 1);
+
+        /// @brief Allocates the texture for all layers and mip levels; no images can be added afterwards.
+        /// @return If the operation was successful or not.
+        bool Build();
+
+        /// @brief Uploads decoded layers until the byte budget of this frame is spent.
+        /// @param budget_bytes Upload budget; at least one layer is uploaded per call if one is ready.
+        /// @return True once every layer is on the graphics device.
+        bool Update(size_t budget_bytes = 1 << 20);
+
+        /// @brief Waits for all decoding jobs and uploads everything that is left.
+        void Finish();
+
+        /// @brief True once every layer is on the graphics device.
+        inline bool IsComplete() const { return m_texture_ != 0 && n_uploaded_images_ == images_.size(); }
+
+        /// @brief Handle for the array texture, 0 before a successful Build.
+        inline GLuint GetTexture() const { return m_texture_; }
+
+        /// @brief The number of layers added so far.
+        inline int GetLayerCount() const { return n_layers_; }
+
+        /// @brief Width and height of every layer in pixels.
+        inline int GetLayerSize() const { return layer_size_; }
+
+    private:
+        /// @brief An added image: its layers and, once decoded, their pixels with all mip levels.
+        struct Image
+        {
+            std::string Path;
+            int Columns;
+            int Rows;
+            int FirstLayer;
+            int FrameCount;
+
+            /// @brief Layer after layer, each with all its mip levels; written by the decoding job.
+            std::vector<unsigned char> Pixels;
+            /// @brief Was the image read from the disk cache.
+            bool Cached = false;
+            /// @brief Could the image not be decoded; its layers are then filled white.
+            bool Failed = false;
+
+            /// @brief Completion of the decoding job.
+            JobSystem::Handle Decoded;
+            /// @brief Layers already uploaded.
+            int UploadedLayers = 0;
+        };
+
+        /// @brief Number of pixel buffer objects uploads cycle through.
+        static constexpr int PBO_COUNT = 3;
+
+        /// @brief Width and height of every layer.
+        int layer_size_;
+        /// @brief Number of mip levels of every layer.
+        int n_levels_;
+        /// @brief Holds the number of layers.
+        int n_layers_ = 0;
+        /// @brief Workers for the decoding jobs, may be null.
+        JobSystem *jobs_;
+        /// @brief Directory of the decoded image cache, empty without caching.
+        std::string cache_directory_;
+
+        /// @brief The added images, in layer order; pointers stay put for the decoding jobs.
+        std::vector<std::unique_ptr<Image>> images_;
+        /// @brief Images fully uploaded; they are uploaded in order.
+        size_t n_uploaded_images_ = 0;
+        /// @brief When the first image was added, for the load time log.
+        std::chrono::steady_clock::time_point start_;
+
+        /// @brief Handle for the array texture.
+        GLuint m_texture_ = 0;
+        /// @brief Handles for the upload ring, one layer with all its mip levels each.
+        GLuint m_pbos_[PBO_COUNT] = {};
+        /// @brief The pixel buffer object the next upload uses.
+        int next_pbo_ = 0;
+
+        /// @brief Bytes of one layer with all its mip levels.
+        size_t LayerBytes_() const;
+
+        /// @brief Decodes an image, or reads it from the cache, into image.Pixels. Runs on a worker.
+        void Decode_(Image &image) const;
+
+        /// @brief Uploads one layer of a decoded image through the next pixel buffer object.
+        void UploadLayer_(Image &image, int layer);
+    };
+};
@@ -33,6 +33,9 @@ namespace RA
         /// Gets the window's perspective matrix.
         glm::mat4 GetPerspectiveMatrix(float fov = 45.f, float nearPlane = 0.1f, float farPlane = 100.f) const;
 
+        /// Gets the framebuffer size in pixels.
+        glm::ivec2 GetFramebufferSize() const;
+
         /// Clears the buffer.
         void Clear(float r, float g, float b, float a);
 
@@ -0,0 +1,55 @@
+#version 460 core
+
+// Bilateral upsample of the low resolution particle layer: the four nearest layer texels are
+// weighted bilinearly and by how close the scene depth at their centers is to the depth of this
+// pixel, so particles do not bleed across depth edges of the scene.
+
+// ### UNIFORM variables.
+uniform sampler2D layer;        // Low resolution particles, premultiplied color and coverage.
+uniform sampler2D scene_depth;  // Full resolution copy of the scene depth buffer.
+uniform float depth_near;       // Near plane of the projection.
+uniform float depth_far;        // Far plane of the projection.
+
+// ### OUT variables
+out vec4 FragColor; // Premultiplied color, blended with (ONE, ONE_MINUS_SRC_ALPHA).
+
+// View distance of a window space depth.
+float LinearDepth(float depth)
+{
+    float ndc = depth * 2.0 - 1.0;
+    return 2.0 * depth_near * depth_far / (depth_far + depth_near - ndc * (depth_far - depth_near));
+}
+
+void main()
+{
+    ivec2 layer_size = textureSize(layer, 0);
+    ivec2 scene_size = textureSize(scene_depth, 0);
+    vec2 ratio = vec2(scene_size) / vec2(layer_size);
+
+    // Position in layer texels, with the texel centers on integer coordinates.
+    vec2 position = gl_FragCoord.xy / ratio - 0.5;
+    ivec2 base = ivec2(floor(position));
+    vec2 f = position - vec2(base);
+
+    float depth = LinearDepth(texelFetch(scene_depth, ivec2(gl_FragCoord.xy), 0).r);
+
+    vec4 color = vec4(0.0);
+    float total = 0.0;
+    for (int i = 0; i < 4; i++)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(base + offset, ivec2(0), layer_size - 1);
+
+        // The scene depth the layer texel was rendered against, at its center.
+        ivec2 center = clamp(ivec2((vec2(texel) + 0.5) * ratio), ivec2(0), scene_size - 1);
+        float texel_depth = LinearDepth(texelFetch(scene_depth, center, 0).r);
+
+        float bilinear = (offset.x == 1 ? f.x : 1.0 - f.x) * (offset.y == 1 ? f.y : 1.0 - f.y);
+        float weight = bilinear / (0.01 + abs(texel_depth - depth) / depth);
+
+        color += texelFetch(layer, texel, 0) * weight;
+        total += weight;
+    }
+
+    FragColor = total > 0.0 ? color / total : vec4(0.0);
+}
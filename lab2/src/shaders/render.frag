@@ -1,24 +1,59 @@
 #version 460 core
 
+// Fragments behind the depth attachment are rejected before shading; there are no depth writes to defer.
+layout(early_fragment_tests) in;
+
 // ### IN variables.
-in float vAge;      // The age of the particle.
-in vec2 vUV;        // The UV coordinate in the fragment/pixel.
-in vec4 pColorTint; // Tint of the particle.
+in float vAge;          // The age of the particle.
+in vec2 vUV;            // The UV coordinate in the fragment/pixel.
+in vec4 pColorTint;     // Tint of the particle.
+flat in int vLayer;     // Layer of the image array, -1 without an image.
+flat in float vSoftDistance; // Fade distance of the particle system.
 
 // ### UNIFORM variables.
-uniform sampler2D image;    // The image texture, if it exists.
-uniform bool has_image;     // Does the image texture exist.
+uniform sampler2DArray images;  // Images of all particle systems, one layer per image or flipbook frame.
+uniform sampler2D scene_depth;  // Copy of the scene depth buffer.
+uniform bool use_scene_depth;   // Discard fragments behind the scene depth.
+uniform bool soft_particles;    // Fade out fragments close to the scene depth.
+uniform vec2 depth_scale;       // Scene depth pixels per target pixel.
+uniform float depth_near;       // Near plane of the projection.
+uniform float depth_far;        // Far plane of the projection.
+uniform bool premultiplied;     // Output the color multiplied by alpha (low resolution pass).
 
 // ### OUT variables
 out vec4 FragColor; // Color of the fragment.
 
+// View distance of a window space depth.
+float LinearDepth(float depth)
+{
+    float ndc = depth * 2.0 - 1.0;
+    return 2.0 * depth_near * depth_far / (depth_far + depth_near - ndc * (depth_far - depth_near));
+}
+
 void main()
 {
-    vec4 image_color = has_image ? texture(image, vUV) : vec4(1.0);
+    // The derivatives are taken before any discard, where they are well defined.
+    vec2 dx = dFdx(vUV);
+    vec2 dy = dFdy(vUV);
 
-    float alpha = image_color.a * pColorTint.a;
+    // Distance to the scene behind the fragment; hidden fragments are dropped before the image is sampled.
+    float fade = 1.0;
+    if (use_scene_depth)
+    {
+        float scene = texelFetch(scene_depth, ivec2(gl_FragCoord.xy * depth_scale), 0).r;
+        float distance = LinearDepth(scene) - LinearDepth(gl_FragCoord.z);
+        if (distance <= 0.0)
+            discard;
+        if (soft_particles)
+            fade = clamp(distance / vSoftDistance, 0.0, 1.0);
+    }
+
+    vec4 image_color = vLayer >= 0 ? textureGrad(images, vec3(vUV, float(vLayer)), dx, dy) : vec4(1.0);
+
+    float alpha = image_color.a * pColorTint.a * fade;
 
     alpha = max(alpha, 0.0);
-    
-    FragColor = vec4(image_color.rgb * pColorTint.rgb, alpha);
-}
\ No newline at end of file
+
+    vec3 color = image_color.rgb * pColorTint.rgb;
+    FragColor = premultiplied ? vec4(color * alpha, alpha) : vec4(color, alpha);
+}
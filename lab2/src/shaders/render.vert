@@ -4,19 +4,41 @@
 layout(location = 0) in vec2 aPos;      // Quad vertex.
 layout(location = 1) in vec2 aUV;       // Quad UV coordinates.
 
-struct Particle
+// A particle that survived culling (cull.compute), already moved to the time of this frame.
+struct RenderParticle
 {
     vec3 position;
     float size;
-    vec3 velocity;
     float age;
-    float life_lentgh;
+    uint system;
 };
 
-// The particles SSBO.
-layout(std430, binding = 0) buffer Particles 
+// Per particle system settings of the systems drawn together.
+struct ParticleSystemData
 {
-    Particle particles[];
+    vec4 start_color;   // Starting color for interpolation.
+    vec4 end_color;     // End color for interpolation.
+    int first_layer;    // First layer of the sprite in the image array, -1 without an image.
+    int frame_count;    // Flipbook frames, in consecutive layers.
+    float frame_loops;  // Times the flipbook plays over the life of a particle.
+    float soft_distance; // View distance over which soft particles fade out in front of the scene.
+};
+
+// Surviving particles of all systems.
+layout(std430, binding = 5) readonly buffer RenderParticles
+{
+    RenderParticle render_particles[];
+};
+
+// Slots in render_particles, sorted back to front; the instance index points into this list.
+layout(std430, binding = 4) readonly buffer SortedValues
+{
+    uint sorted_slots[];
+};
+
+layout(std430, binding = 6) readonly buffer ParticleSystems
+{
+    ParticleSystemData systems[];
 };
 
 // ### UNIFORM variables.
@@ -24,28 +46,19 @@ uniform mat4 view;  // Camera view matrix.
 uniform mat4 proj;  // Window projection matrix.
 uniform vec3 cam_right;
 uniform vec3 cam_up;
-uniform vec3 cam_forward;
-uniform vec4 start_color;   // Starting color for interpolation.
-uniform vec4 end_color;     // End color for interpolation.
 
 // ### OUT variables.
-out float vAge;         // Age of the particle (for the color interpolation), will be the same for all four vertices.
-out vec2 vUV;           // UV coordinates per vertex (interpolated).
-out vec4 pColorTint;    // Tint of the particle.
+out float vAge;             // Age of the particle (for the color interpolation), will be the same for all four vertices.
+out vec2 vUV;               // UV coordinates per vertex (interpolated).
+out vec4 pColorTint;        // Tint of the particle.
+flat out int vLayer;        // Layer of the image array to sample, -1 without an image.
+flat out float vSoftDistance; // Fade distance of the particle system.
 
 void main()
 {
     // Get the particle to render.
-    Particle p = particles[gl_InstanceID];
-
-    // If the particle's age is less than 0, return nullable data.
-    if (p.age < 0.0)
-    {
-        gl_Position = vec4(0,0,0,1);
-        vAge = 0.0;
-        vUV = vec2(0.0,0.0);
-        return;
-    }
+    RenderParticle p = render_particles[sorted_slots[gl_InstanceID]];
+    ParticleSystemData system = systems[p.system];
 
     // Scale quad by particle size.
     vec3 offset = (cam_right * aPos.x + cam_up * aPos.y) * p.size;
@@ -55,5 +68,10 @@ void main()
 
     vAge = p.age;
     vUV = aUV;
-    pColorTint = mix(start_color, end_color, p.age);
-}
\ No newline at end of file
+    pColorTint = mix(system.start_color, system.end_color, p.age);
+
+    // The flipbook frame follows the age of the particle (0 at birth, 1 at death).
+    int frame = int(p.age * system.frame_loops * float(system.frame_count)) % system.frame_count;
+    vLayer = system.first_layer < 0 ? -1 : system.first_layer + frame;
+    vSoftDistance = system.soft_distance;
+}
@@ -1,4 +1,5 @@
 #include "Application.hpp"
+#include "Profiler.hpp"
 
 namespace RA::Application
 {
@@ -7,6 +8,12 @@ namespace RA::Application
     std::shared_ptr<RA::ParticleSystem> CloudPS = nullptr;
     std::shared_ptr<RA::ParticleSystem> StarsPS = nullptr;
     std::shared_ptr<RA::ParticleSystem> SnowPS = nullptr;
+    std::shared_ptr<RA::JobSystem> Jobs = nullptr;
+    std::shared_ptr<RA::TextureArray> Images = nullptr;
+    std::shared_ptr<RA::ParticleRenderer> Particles = nullptr;
+    std::shared_ptr<RA::RenderTarget> SceneTarget = nullptr;
+    std::string TraceFile;
+    RA::FixedTimestep Timestep(1.0 / 120.0, 8);
 }
 
 void RA::Application::Initialize()
@@ -14,8 +21,17 @@ void RA::Application::Initialize()
     Window = std::make_shared<RA::Window>(1000, 800, "2nd Laboratory Exercise");
     Camera = std::make_shared<RA::Camera>();
 
+    // All particle images share one array texture, so the systems are drawn together. They are decoded
+    // on the workers (or read from the cache) meanwhile, and uploaded by Images->Update in the first frames.
+    Jobs = std::make_shared<RA::JobSystem>();
+    Images = std::make_shared<RA::TextureArray>(256, Jobs.get());
+    RA::Sprite cloud = Images->Add("assets/cloud.png");
+    RA::Sprite star = Images->Add("assets/star.png");
+    RA::Sprite snow = Images->Add("assets/snow.png");
+    Images->Build();
+
     CloudPS = std::make_shared<RA::ParticleSystem>(10);
-    CloudPS->LoadTexture("assets/cloud.png");
+    CloudPS->SetSprite(cloud);
     CloudPS->Properties.MaximumLifeLength = 160.f;
     CloudPS->Properties.MinimumLifeLength = 80.f;
     CloudPS->Properties.StartColor = glm::vec4(0.7, 0.7, 0.7, 0.8);
@@ -28,9 +44,11 @@ void RA::Application::Initialize()
     CloudPS->Properties.Gravity = false;
     CloudPS->Properties.SizeFalloff = 0.0f;
     CloudPS->Properties.StartVelocityStrength = 0.f;
+    CloudPS->Properties.SoftDistance = 4.f;
+    CloudPS->Properties.LowResolution = true;
 
     StarsPS = std::make_shared<RA::ParticleSystem>(100);
-    StarsPS->LoadTexture("assets/star.png");
+    StarsPS->SetSprite(star);
     StarsPS->Properties.MaximumLifeLength = 1000.f;
     StarsPS->Properties.MinimumLifeLength = 100.f;
     StarsPS->Properties.StartColor = glm::vec4(1.0, 1.0, 1.0, 0.8);
@@ -44,7 +62,7 @@ void RA::Application::Initialize()
     StarsPS->Properties.StartVelocityStrength = 0.f;
 
     SnowPS = std::make_shared<RA::ParticleSystem>(100);
-    SnowPS->LoadTexture("assets/snow.png");
+    SnowPS->SetSprite(snow);
     SnowPS->Properties.MaximumLifeLength = 8.f;
     SnowPS->Properties.MinimumLifeLength = 4.f;
     SnowPS->Properties.StartColor = glm::vec4(1.0, 1.0, 1.0, 0.9);
@@ -57,6 +75,15 @@ void RA::Application::Initialize()
     SnowPS->Properties.Gravity = true;
     SnowPS->Properties.StartVelocityStrength = 0.9f;
     SnowPS->Properties.SizeFalloff = 0.0f;
+
+    // Particles of all systems are sorted together, so the order of the systems does not matter.
+    Particles = std::make_shared<RA::ParticleRenderer>(std::vector<std::shared_ptr<RA::ParticleSystem>>{CloudPS, StarsPS, SnowPS}, Images);
+    Particles->SoftParticles = true;
+
+    SceneTarget = std::make_shared<RA::RenderTarget>(GL_RGBA8, true);
+
+    if (!TraceFile.empty())
+        RA::Profiler::Enable();
 }
 
 void InputMoveCamera(GLFWwindow *window, float delta_time, std::shared_ptr<RA::Camera> &camera)
@@ -117,10 +144,15 @@ void InputMoveCamera(GLFWwindow *window, float delta_time, std::shared_ptr<RA::C
 
 void RA::Application::Run()
 {
-    float last_frame = 0.0f;
+    float last_frame = static_cast<float>(glfwGetTime());
 
     while (!Window->ShouldClose())
     {
+        RA::Profiler::BeginFrame();
+
+        glm::ivec2 framebuffer_size = Window->GetFramebufferSize();
+        SceneTarget->Resize(framebuffer_size);
+        SceneTarget->Bind();
         Window->Clear(0.039, 0.039, 0.118, 1);
 
         // Calculate the delta_time
@@ -131,16 +163,41 @@ void RA::Application::Run()
         // Input: Camera Movement.
         InputMoveCamera(Window->GetNativeHandle(), delta_time, Camera);
 
-        CloudPS->Update(delta_time);
-        StarsPS->Update(delta_time);
-        SnowPS->Update(delta_time);
+        // Simulate in fixed steps, independent of the frame rate.
+        {
+            RA_PROFILE_SCOPE("Update");
+            int steps = Timestep.Advance(delta_time);
+            float step = static_cast<float>(Timestep.Step());
+            for (int i = 0; i < steps; i++)
+            {
+                CloudPS->Update(step);
+                StarsPS->Update(step);
+                SnowPS->Update(step);
+            }
+        }
 
-        // Render all particle systems.
-        StarsPS->Render(Camera, Window);
-        CloudPS->Render(Camera, Window);
-        SnowPS->Render(Camera, Window);
+        // Render all particle systems, moved forward by the time not simulated yet.
+        {
+            Images->Update();
+            RA_PROFILE_SCOPE("Render");
+            float time_ahead = Timestep.Alpha() * static_cast<float>(Timestep.Step());
+            Particles->Render(Camera, Window, time_ahead, SceneTarget.get());
+            SceneTarget->BlitToScreen(framebuffer_size);
+        }
+
+        {
+            RA_PROFILE_SCOPE("Swap buffers");
+            Window->SwapBuffers();
+            Window->PollEvents();
+        }
 
-        Window->SwapBuffers();
-        Window->PollEvents();
+        RA::Profiler::EndFrame();
+    }
+
+    // Export while the GL context is still alive, the queries belong to it.
+    if (RA::Profiler::IsEnabled())
+    {
+        RA::Profiler::ExportChromeTrace(TraceFile);
+        RA::Profiler::Shutdown();
     }
 }
\ No newline at end of file
@@ -5,7 +5,12 @@ namespace RA::Assets
     std::shared_ptr<RA::ComputeShader> BirthCompute = nullptr;
     std::shared_ptr<RA::ComputeShader> LifeCompute = nullptr;
     std::shared_ptr<RA::ComputeShader> DeadResetCompute = nullptr;
+    std::shared_ptr<RA::ComputeShader> CullCompute = nullptr;
+    std::shared_ptr<RA::ComputeShader> RadixHistogramCompute = nullptr;
+    std::shared_ptr<RA::ComputeShader> RadixScanCompute = nullptr;
+    std::shared_ptr<RA::ComputeShader> RadixScatterCompute = nullptr;
     std::shared_ptr<RA::RenderShader> Render = nullptr;
+    std::shared_ptr<RA::RenderShader> Composite = nullptr;
 }
 
 void RA::Assets::Load()
@@ -13,5 +18,10 @@ void RA::Assets::Load()
     BirthCompute = ComputeShader::LoadShader("birth");
     LifeCompute = ComputeShader::LoadShader("life");
     DeadResetCompute = ComputeShader::LoadShader("deadreset");
+    CullCompute = ComputeShader::LoadShader("cull");
+    RadixHistogramCompute = ComputeShader::LoadShader("radix_histogram");
+    RadixScanCompute = ComputeShader::LoadShader("radix_scan");
+    RadixScatterCompute = ComputeShader::LoadShader("radix_scatter");
     Render = RenderShader::LoadShader("render");
+    Composite = RenderShader::LoadShader("composite");
 }
\ No newline at end of file
@@ -2,20 +2,18 @@
 
 RA::Camera::Camera()
     : _position(0.f, 0.f, 0.f),
-      _front(0.f, 0.f, -1.f),
-      _up(0.f, 1.f, 0.f),
-      _yaw(-90.f),
+      _orientation(1.f, 0.f, 0.f, 0.f),
       _pitch(0.f),
+      _rotationsSinceNormalize(0),
       _dirty(true)
 {
-    RecalculateVectors();
 }
 
 glm::mat4 RA::Camera::GetViewMatrix()
 {
     if (_dirty)
     {
-        _view = glm::lookAt(_position, _position + _front, _up);
+        _view = glm::lookAt(_position, _position + GetFront(), GetUp());
         _dirty = false;
     }
     return _view;
@@ -29,9 +27,7 @@ void RA::Camera::Move(const glm::vec3 &deltaWorld)
 
 void RA::Camera::MoveLocal(const glm::vec3 &deltaLocal)
 {
-    _position += right * deltaLocal.x;
-    _position += _up * deltaLocal.y;
-    _position += _front * deltaLocal.z;
+    _position += _orientation * glm::vec3(deltaLocal.x, deltaLocal.y, -deltaLocal.z);
     _dirty = true;
 }
 
@@ -40,13 +36,21 @@ void RA::Camera::Rotate(float yawOffset, float pitchOffset, float sensitivity, b
     yawOffset *= sensitivity;
     pitchOffset *= sensitivity;
 
-    _yaw += yawOffset;
+    if (limitPitch)
+        pitchOffset = glm::clamp(_pitch + pitchOffset, -89.f, 89.f) - _pitch;
     _pitch += pitchOffset;
 
-    if (limitPitch)
-        _pitch = glm::clamp(_pitch, -89.f, 89.f);
+    // Yaw turns around the world up, pitch around the camera's own right axis.
+    glm::quat yaw = glm::angleAxis(glm::radians(-yawOffset), glm::vec3(0.f, 1.f, 0.f));
+    glm::quat pitch = glm::angleAxis(glm::radians(pitchOffset), glm::vec3(1.f, 0.f, 0.f));
+    _orientation = yaw * _orientation * pitch;
+
+    if (++_rotationsSinceNormalize >= RENORMALIZE_INTERVAL)
+    {
+        _orientation = glm::normalize(_orientation);
+        _rotationsSinceNormalize = 0;
+    }
 
-    RecalculateVectors();
     _dirty = true;
 }
 
@@ -58,26 +62,15 @@ void RA::Camera::SetPosition(const glm::vec3 &p)
 
 void RA::Camera::SetOrientation(const glm::vec3 &newFront, const glm::vec3 &worldUp)
 {
-    _front = glm::normalize(newFront);
+    glm::vec3 front = glm::normalize(newFront);
+    glm::vec3 right = glm::normalize(glm::cross(front, worldUp));
+    glm::vec3 up = glm::cross(right, front);
 
-    right = glm::normalize(glm::cross(_front, worldUp));
-    _up = glm::normalize(glm::cross(right, _front));
+    _orientation = glm::normalize(glm::quat_cast(glm::mat3(right, up, -front)));
+    _rotationsSinceNormalize = 0;
 
-    // Recover yaw/pitch from direction
-    _yaw = glm::degrees(atan2(_front.z, _front.x)) - 90.f;
-    _pitch = glm::degrees(asin(_front.y));
+    // Recover the pitch from the direction, for the pitch limit.
+    _pitch = glm::degrees(asin(glm::clamp(front.y, -1.f, 1.f)));
 
     _dirty = true;
 }
-
-void RA::Camera::RecalculateVectors()
-{
-    glm::vec3 direction;
-    direction.x = cos(glm::radians(_yaw)) * cos(glm::radians(_pitch));
-    direction.y = sin(glm::radians(_pitch));
-    direction.z = sin(glm::radians(_yaw)) * cos(glm::radians(_pitch));
-
-    _front = glm::normalize(direction);
-    right = glm::normalize(glm::cross(_front, glm::vec3(0.f, 1.f, 0.f)));
-    _up = glm::normalize(glm::cross(right, _front));
-}
\ No newline at end of file
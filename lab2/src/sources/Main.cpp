@@ -1,17 +1,33 @@
 // Local
 #include "Application.hpp"
 #include "Assets.hpp"
+#include "GLState.hpp"
+#include "ParticleSorter.hpp"
 // Standard
 #include <iostream>
 #include <memory>
+#include <string>
 // External
 
 using namespace RA;
 
 int main(int argc, char *argv[])
 {
+    // Optional profiling: --trace <trace.json> writes the last frames as a Chrome trace at exit.
+    if (argc >= 3 && std::string(argv[1]) == "--trace")
+        Application::TraceFile = argv[2];
+
     Application::Initialize();
     Assets::Load();
 
+    // GPU sort benchmark: --bench-sort [keys] [iterations] times the radix sort alone, without drawing.
+    if (argc >= 2 && std::string(argv[1]) == "--bench-sort")
+    {
+        ParticleSorter::Benchmark(argc >= 3 ? std::stoul(argv[2]) : 1000000, argc >= 4 ? std::stoi(argv[3]) : 20);
+        return 0;
+    }
+
     Application::Run();
+
+    GLState::PrintStats();
 }
\ No newline at end of file
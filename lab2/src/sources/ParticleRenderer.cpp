@@ -0,0 +1,351 @@
+#include "ParticleRenderer.hpp"
+
+// Local
+#include "Camera.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
+#include "Window.hpp"
+// Standard
+#include <algorithm>
+#include <string>
+
+using namespace RA;
+using namespace RA::Assets;
+
+namespace
+{
+    /// Size of one RenderParticle in cull.compute / render.vert (std430: vec3, 3 scalars, padded to 32 bytes).
+    constexpr unsigned int RENDER_PARTICLE_SIZE = 32;
+
+    unsigned int TotalParticles(const std::vector<std::shared_ptr<ParticleSystem>> &systems)
+    {
+        unsigned int total = 0;
+        for (const std::shared_ptr<ParticleSystem> &system : systems)
+            total += system->GetMaxParticles();
+        return total;
+    }
+
+    /// Near and far view distance of a perspective projection.
+    glm::vec2 DepthRange(const glm::mat4 &proj)
+    {
+        return glm::vec2(proj[3][2] / (proj[2][2] - 1.0f), proj[3][2] / (proj[2][2] + 1.0f));
+    }
+}
+
+ParticleRenderer::ParticleRenderer(const std::vector<std::shared_ptr<ParticleSystem>> &systems,
+                                   std::shared_ptr<TextureArray> images)
+    : systems_(systems), images_(std::move(images)), n_max_particles_(TotalParticles(systems)),
+      sorter_(TotalParticles(systems)), low_resolution_(GL_RGBA16F, false)
+{
+    InitializeBuffers_();
+    InitializeRendering_();
+}
+
+ParticleRenderer::~ParticleRenderer()
+{
+    GLState::DeleteBuffer(m_ssbo_render_particles_);
+    GLState::DeleteBuffer(m_ssbo_systems_);
+    GLState::DeleteBuffer(m_indirect_);
+    GLState::DeleteBuffer(m_vbo_);
+    GLState::DeleteVertexArray(m_vao_);
+    if (m_scene_depth_ != 0)
+        GLState::DeleteTexture(m_scene_depth_);
+}
+
+void ParticleRenderer::InitializeBuffers_()
+{
+    // Initialize the shared particle list SSBO, filled by the culling passes every frame.
+    glGenBuffers(1, &m_ssbo_render_particles_);
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo_render_particles_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, RENDER_PARTICLE_SIZE * std::max(n_max_particles_, 1u), nullptr, GL_DYNAMIC_DRAW);
+
+    // Initialize the per system settings SSBO, updated every frame from the Properties.
+    glGenBuffers(1, &m_ssbo_systems_);
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo_systems_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(SystemData) * std::max(systems_.size(), (size_t)1), nullptr, GL_DYNAMIC_DRAW);
+
+    // Initialize the indirect draw command: 4 vertices per quad, instance count written by the culling passes.
+    GLuint command[4] = {4, 0, 0, 0};
+    glGenBuffers(1, &m_indirect_);
+    GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirect_);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(command), command, GL_DYNAMIC_DRAW);
+}
+
+void ParticleRenderer::InitializeRendering_()
+{
+    // Initialize the VAO.
+    glGenVertexArrays(1, &m_vao_);
+    GLState::BindVertexArray(m_vao_);
+
+    // Initialize the VBO.
+    glGenBuffers(1, &m_vbo_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_vbo_);
+
+    // Create a quad data array which holds (x,y,u,v) for each corner of the quad.
+    float quad_data[] =
+        {
+            -0.5f, -0.5f, 0.0f, 0.0f, // bottom-left
+            0.5f, -0.5f, 1.0f, 0.0f,  // bottom-right
+            -0.5f, 0.5f, 0.0f, 1.0f,  // top-left
+            0.5f, 0.5f, 1.0f, 1.0f    // top-right
+        };
+
+    // Store the quad data inside the VBO.
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad_data), quad_data, GL_STATIC_DRAW);
+
+    // Assign vertex attribute for position (vec2).
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0 /*location in shader*/,
+        2 /* vec2 */,
+        GL_FLOAT,
+        GL_FALSE,
+        4 * sizeof(float) /* stride */,
+        (void *)0 /* offset */
+    );
+
+    // Assign vertex attribute for UV (vec2).
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1 /*location in shader*/,
+        2 /* vec2 */,
+        GL_FLOAT,
+        GL_FALSE,
+        4 * sizeof(float) /* stride */,
+        (void *)(2 * sizeof(float)) /* offset after x,y */
+    );
+
+    // Unbind.
+    GLState::BindVertexArray(0);
+}
+
+bool ParticleRenderer::Cull_(Camera &cam, Window &win, float time_ahead, Pass pass, glm::ivec2 target_size)
+{
+    RA_PROFILE_GPU("Particle cull");
+
+    glm::mat4 view = cam.GetViewMatrix();
+    glm::mat4 proj = win.GetPerspectiveMatrix();
+
+    // Frustum planes from the rows of proj * view (glm is column-major): left, right, bottom, top, near, far.
+    glm::mat4 view_proj = proj * view;
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; i++)
+        row[i] = glm::vec4(view_proj[0][i], view_proj[1][i], view_proj[2][i], view_proj[3][i]);
+
+    glm::vec4 planes[6] = {row[3] + row[0], row[3] - row[0],
+                           row[3] + row[1], row[3] - row[1],
+                           row[3] + row[2], row[3] - row[2]};
+
+    // Near and far distance of the perspective projection, the range of the sort keys.
+    glm::vec2 depth_range = DepthRange(proj);
+
+    // Reset the instance count; the vertex count stays 4.
+    GLuint command[4] = {4, 0, 0, 0};
+    GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirect_);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(command), command);
+
+    // Reset the sort tiles; the culling pass raises them to cover the survivors.
+    sorter_.ResetDispatch();
+
+    CullCompute->Use();
+    CullCompute->SetUniform("time_ahead", time_ahead);
+    CullCompute->SetUniform("view", view);
+    for (int i = 0; i < 6; i++)
+        CullCompute->SetUniform("planes[" + std::to_string(i) + "]", planes[i] / glm::length(glm::vec3(planes[i])));
+
+    // A particle of size s at view depth d covers s * proj[1][1] * height / (2 d) pixels of the target.
+    CullCompute->SetUniform("pixel_scale", proj[1][1] * 0.5f * target_size.y);
+    CullCompute->SetUniform("depth_near", depth_range.x);
+    CullCompute->SetUniform("depth_far", depth_range.y);
+
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_indirect_);
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, sorter_.GetKeyBuffer());
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, sorter_.GetValueBuffer());
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, m_ssbo_render_particles_);
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, sorter_.GetDispatchBuffer());
+
+    // All systems of the pass append to the same list; the atomic counter keeps their ranges apart.
+    bool any = false;
+    for (unsigned int i = 0; i < systems_.size(); i++)
+    {
+        ParticleSystem &system = *systems_[i];
+
+        if (pass != Pass::All && system.Properties.LowResolution != (pass == Pass::LowResolution))
+            continue;
+        any = true;
+
+        CullCompute->SetUniform("max_particles", (int)system.GetMaxParticles());
+        CullCompute->SetUniform("min_pixel_size", system.Properties.MinimumPixelSize);
+        CullCompute->SetUniform("system_index", i);
+
+        GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, system.GetParticleBuffer());
+
+        glDispatchCompute((system.GetMaxParticles() + 127) / 128, 1, 1);
+    }
+
+    // The sort and render passes read the list as SSBOs, the count and the sort tiles as indirect commands.
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+    return any;
+}
+
+void ParticleRenderer::Draw_(Camera &cam, Window &win, bool scene_depth, glm::ivec2 target_size, bool premultiplied)
+{
+    // Back to front; the keys are 16 bits, so two passes.
+    bool sorted = Sorted && sorter_.Sort(m_indirect_, 1, 16);
+    GLuint order = sorted ? sorter_.GetSortedValues() : sorter_.GetValueBuffer();
+
+    RA_PROFILE_GPU("Particle render");
+
+    glm::mat4 proj = win.GetPerspectiveMatrix();
+    glm::vec2 depth_range = DepthRange(proj);
+
+    // Set uniform variables from cam and win.
+    Assets::Render->Use();
+    Assets::Render->SetUniform("view", cam.GetViewMatrix());
+    Assets::Render->SetUniform("proj", proj);
+    Assets::Render->SetUniform("cam_right", cam.GetRight());
+    Assets::Render->SetUniform("cam_up", cam.GetUp());
+    Assets::Render->SetUniform("images", 0);
+
+    // The scene depth copy is bound after the images; its pixels map onto the target by depth_scale.
+    Assets::Render->SetUniform("use_scene_depth", scene_depth);
+    Assets::Render->SetUniform("soft_particles", scene_depth && SoftParticles);
+    Assets::Render->SetUniform("scene_depth", 1);
+    Assets::Render->SetUniform("depth_scale", glm::vec2(scene_depth_size_) / glm::vec2(target_size));
+    Assets::Render->SetUniform("depth_near", depth_range.x);
+    Assets::Render->SetUniform("depth_far", depth_range.y);
+    Assets::Render->SetUniform("premultiplied", premultiplied);
+    if (scene_depth)
+        GLState::BindTexture(1, GL_TEXTURE_2D, m_scene_depth_);
+
+    // Bind the shared particle list, the draw order and the system settings.
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, order);
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, m_ssbo_render_particles_);
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_ssbo_systems_);
+
+    // Do instanced rendering of the quad for every visible particle; the instance count comes from the culling pass.
+    GLState::BindVertexArray(m_vao_);
+    GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirect_);
+    glDrawArraysIndirect(GL_TRIANGLE_STRIP, nullptr);
+}
+
+void ParticleRenderer::CopySceneDepth_(const RenderTarget &scene)
+{
+    if (m_scene_depth_ == 0)
+    {
+        glGenTextures(1, &m_scene_depth_);
+        GLState::BindTexture(0, GL_TEXTURE_2D, m_scene_depth_);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    if (scene_depth_size_ != scene.GetSize())
+    {
+        scene_depth_size_ = scene.GetSize();
+        GLState::BindTexture(0, GL_TEXTURE_2D, m_scene_depth_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, scene_depth_size_.x, scene_depth_size_.y, 0,
+                     GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    }
+
+    // Sampling the attached depth texture while testing against it would be a feedback loop, so read a copy.
+    glCopyImageSubData(scene.GetDepthTexture(), GL_TEXTURE_2D, 0, 0, 0, 0,
+                       m_scene_depth_, GL_TEXTURE_2D, 0, 0, 0, 0,
+                       scene_depth_size_.x, scene_depth_size_.y, 1);
+}
+
+void ParticleRenderer::Composite_(Window &win)
+{
+    RA_PROFILE_GPU("Particle composite");
+
+    glm::vec2 depth_range = DepthRange(win.GetPerspectiveMatrix());
+
+    Composite->Use();
+    Composite->SetUniform("layer", 0);
+    Composite->SetUniform("scene_depth", 1);
+    Composite->SetUniform("depth_near", depth_range.x);
+    Composite->SetUniform("depth_far", depth_range.y);
+    GLState::BindTexture(0, GL_TEXTURE_2D, low_resolution_.GetColorTexture());
+    GLState::BindTexture(1, GL_TEXTURE_2D, m_scene_depth_);
+
+    // One triangle covering the screen, built from gl_VertexID; the quad VAO is bound only because a VAO must be.
+    GLState::SetCapability(GL_DEPTH_TEST, false);
+    GLState::BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::BindVertexArray(m_vao_);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    GLState::SetCapability(GL_DEPTH_TEST, true);
+}
+
+void ParticleRenderer::Render(std::shared_ptr<Camera> cam, std::shared_ptr<Window> win, float time_ahead,
+                              const RenderTarget *scene)
+{
+    // Don't render if there is not a render shader.
+    if (!Assets::Render)
+        return;
+
+    if (!CullCompute)
+    {
+        std::cerr << "ParticleRenderer: Cull compute shader not loaded!\n";
+        return;
+    }
+
+    // The scene depth is needed to discard and fade particles, and to upsample the low resolution pass.
+    bool scene_depth = scene && scene->GetDepthTexture() != 0;
+    bool layered = scene_depth && Composite && LowResolutionDivisor > 1 &&
+                   std::any_of(systems_.begin(), systems_.end(),
+                               [](const std::shared_ptr<ParticleSystem> &system)
+                               { return system->Properties.LowResolution; });
+    if (scene_depth && (SoftParticles || layered))
+        CopySceneDepth_(*scene);
+    else
+        scene_depth = false;
+
+    glm::ivec2 scene_size = scene ? scene->GetSize() : win->GetFramebufferSize();
+
+    // Upload the settings of every system; a system without a sprite gets layer -1 and is drawn untextured.
+    bool has_images = images_ && images_->GetTexture() != 0;
+    std::vector<SystemData> data(systems_.size());
+    for (unsigned int i = 0; i < systems_.size(); i++)
+    {
+        const ParticleSystem &system = *systems_[i];
+        const Sprite &sprite = system.GetSprite();
+        data[i].StartColor = system.Properties.StartColor;
+        data[i].EndColor = system.Properties.EndColor;
+        data[i].FirstLayer = has_images && sprite.Valid() ? sprite.FirstLayer : -1;
+        data[i].FrameCount = std::max(sprite.FrameCount, 1);
+        data[i].FrameLoops = system.Properties.FlipbookLoops;
+        data[i].SoftDistance = std::max(system.Properties.SoftDistance, 1e-4f);
+    }
+    if (has_images)
+        GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, images_->GetTexture());
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo_systems_);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(SystemData) * data.size(), data.data());
+
+    // Disable the depth mask for transparency. It stays disabled for the following draws
+    // and is enabled again by Window::Clear, which needs it to clear the depth buffer.
+    GLState::DepthMask(false);
+
+    // Full resolution systems are tested against the scene depth attached to the bound target.
+    if (Cull_(*cam, *win, time_ahead, layered ? Pass::FullResolution : Pass::All, scene_size))
+        Draw_(*cam, *win, scene_depth, scene_size, false);
+
+    if (!layered)
+        return;
+
+    // Low resolution systems: premultiplied colors accumulate over transparent black, then the layer
+    // is composited over the scene and the full resolution particles in one pass. The culling and sort buffers are reused.
+    low_resolution_.Resize(scene_size / (int)LowResolutionDivisor);
+    low_resolution_.Bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    Cull_(*cam, *win, time_ahead, Pass::LowResolution, low_resolution_.GetSize());
+
+    GLState::BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    Draw_(*cam, *win, true, low_resolution_.GetSize(), true);
+
+    scene->Bind();
+    Composite_(*win);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
@@ -0,0 +1,195 @@
+#include "ParticleSorter.hpp"
+
+// Local
+#include "Assets.hpp"
+#include "GLState.hpp"
+#include "Profiler.hpp"
+// Standard
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+using namespace RA;
+using namespace RA::Assets;
+
+ParticleSorter::ParticleSorter(unsigned int max_keys)
+    : n_max_keys_(std::max(max_keys, 1u)), n_groups_((std::max(max_keys, 1u) + TILE - 1) / TILE)
+{
+    GLuint *buffers[] = {&m_keys_[0], &m_keys_[1], &m_values_[0], &m_values_[1]};
+    for (GLuint *buffer : buffers)
+    {
+        glGenBuffers(1, buffer);
+        GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, *buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(unsigned int) * n_max_keys_, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    // One count per digit per tile.
+    glGenBuffers(1, &m_histogram_);
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_histogram_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(unsigned int) * 256 * n_groups_, nullptr, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(1, &m_dispatch_);
+    GLState::BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_dispatch_);
+    glBufferData(GL_DISPATCH_INDIRECT_BUFFER, sizeof(unsigned int) * 3, nullptr, GL_DYNAMIC_DRAW);
+    ResetDispatch(n_groups_);
+}
+
+ParticleSorter::~ParticleSorter()
+{
+    GLState::DeleteBuffer(m_keys_[0]);
+    GLState::DeleteBuffer(m_keys_[1]);
+    GLState::DeleteBuffer(m_values_[0]);
+    GLState::DeleteBuffer(m_values_[1]);
+    GLState::DeleteBuffer(m_histogram_);
+    GLState::DeleteBuffer(m_dispatch_);
+}
+
+void ParticleSorter::ResetDispatch(unsigned int tiles)
+{
+    GLuint command[3] = {std::min(tiles, n_groups_), 1, 1};
+    GLState::BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_dispatch_);
+    glBufferSubData(GL_DISPATCH_INDIRECT_BUFFER, 0, sizeof(command), command);
+}
+
+bool ParticleSorter::Sort(GLuint count_buffer, unsigned int count_index, unsigned int key_bits)
+{
+    if (!RadixHistogramCompute || !RadixScanCompute || !RadixScatterCompute)
+    {
+        std::cerr << "ParticleSorter: Sort compute shaders not loaded!\n";
+        return false;
+    }
+
+    RA_PROFILE_GPU("Particle sort");
+
+    unsigned int passes = (std::min(key_bits, 32u) + 7) / 8;
+    unsigned int input = 0;
+
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, m_histogram_);
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, count_buffer);
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, m_dispatch_);
+
+    // Only the tiles holding keys are dispatched, and the histogram is packed for that many tiles,
+    // so a frame with few survivors sorts few tiles and scans a short histogram.
+    GLState::BindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_dispatch_);
+
+    for (unsigned int pass = 0; pass < passes; pass++)
+    {
+        unsigned int output = 1 - input;
+
+        // Count the digits of every tile.
+        RadixHistogramCompute->Use();
+        RadixHistogramCompute->SetUniform("count_index", count_index);
+        RadixHistogramCompute->SetUniform("shift", pass * 8);
+        GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_keys_[input]);
+
+        glDispatchComputeIndirect(0);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        // Turn the counts into output offsets.
+        RadixScanCompute->Use();
+
+        glDispatchCompute(1, 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        // Move the pairs to their offsets.
+        RadixScatterCompute->Use();
+        RadixScatterCompute->SetUniform("count_index", count_index);
+        RadixScatterCompute->SetUniform("shift", pass * 8);
+        GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_keys_[input]);
+        GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_values_[input]);
+        GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_keys_[output]);
+        GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_values_[output]);
+
+        glDispatchComputeIndirect(0);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        input = output;
+    }
+
+    n_result_ = input;
+    return true;
+}
+
+void ParticleSorter::Benchmark(unsigned int count, int iterations)
+{
+    count = std::max(count, 1u);
+    iterations = std::max(iterations, 1);
+
+    std::srand(1234);
+    std::vector<unsigned int> keys(count);
+    for (unsigned int &key : keys)
+        key = (static_cast<unsigned int>(std::rand()) << 16) ^ static_cast<unsigned int>(std::rand());
+
+    std::vector<unsigned int> values(count);
+    std::iota(values.begin(), values.end(), 0u);
+
+    ParticleSorter sorter(count);
+    sorter.ResetDispatch((count + TILE - 1) / TILE);
+
+    // The source data is kept on the GPU and copied in before every sort, outside the timed range.
+    GLuint source = 0, counter = 0, query = 0;
+    glGenBuffers(1, &source);
+    GLState::BindBuffer(GL_COPY_READ_BUFFER, source);
+    glBufferData(GL_COPY_READ_BUFFER, sizeof(unsigned int) * count, keys.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &counter);
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, counter);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(unsigned int), &count, GL_STATIC_DRAW);
+
+    glGenQueries(1, &query);
+
+    for (unsigned int bits : {16u, 32u})
+    {
+        double best = 1e30;
+        double total = 0.0;
+
+        // One untimed sort first, so shader compilation and first use are not measured.
+        for (int it = -1; it < iterations; it++)
+        {
+            GLState::BindBuffer(GL_COPY_READ_BUFFER, source);
+            GLState::BindBuffer(GL_COPY_WRITE_BUFFER, sorter.GetKeyBuffer());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(unsigned int) * count);
+            GLState::BindBuffer(GL_COPY_WRITE_BUFFER, sorter.GetValueBuffer());
+            glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(unsigned int) * count, values.data());
+
+            glBeginQuery(GL_TIME_ELAPSED, query);
+            if (!sorter.Sort(counter, 0, bits))
+                return;
+            glEndQuery(GL_TIME_ELAPSED);
+
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+            if (it >= 0)
+            {
+                best = std::min(best, elapsed * 1e-6);
+                total += elapsed * 1e-6;
+            }
+        }
+
+        // Check the order and that every value still belongs to its key.
+        std::vector<unsigned int> sorted_keys(count), sorted_values(count);
+        GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, sorter.GetSortedKeys());
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(unsigned int) * count, sorted_keys.data());
+        GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, sorter.GetSortedValues());
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(unsigned int) * count, sorted_values.data());
+
+        unsigned int mask = bits >= 32 ? 0xFFFFFFFFu : (1u << bits) - 1;
+        bool valid = true;
+        for (unsigned int i = 0; i < count && valid; i++)
+        {
+            valid = sorted_values[i] < count && sorted_keys[i] == keys[sorted_values[i]];
+            if (i > 0)
+                valid = valid && (sorted_keys[i - 1] & mask) <= (sorted_keys[i] & mask);
+        }
+
+        std::cout << "[BENCH]: radix sort, " << bits << "-bit keys: " << count << " pairs, best " << best << " ms, average "
+                  << total / iterations << " ms, " << count / best * 1e-3 << " Mkeys/s" << std::endl;
+        if (!valid)
+            std::cout << "[ERROR]: radix sort, " << bits << "-bit keys: the output is not sorted" << std::endl;
+    }
+
+    glDeleteQueries(1, &query);
+    GLState::DeleteBuffer(source);
+    GLState::DeleteBuffer(counter);
+}
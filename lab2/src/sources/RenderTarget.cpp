@@ -0,0 +1,95 @@
+#include "RenderTarget.hpp"
+
+// Local
+#include "GLState.hpp"
+// Standard
+#include <algorithm>
+
+using namespace RA;
+
+RenderTarget::RenderTarget(GLenum color_format, bool depth)
+    : color_format_(color_format)
+{
+    glGenFramebuffers(1, &m_fbo_);
+    glGenTextures(1, &m_color_);
+    if (depth)
+        glGenTextures(1, &m_depth_);
+
+    // Every pass reads single texels (texelFetch or a blit), so no filtering and no mipmaps.
+    GLuint textures[] = {m_color_, m_depth_};
+    for (GLuint texture : textures)
+    {
+        if (texture == 0)
+            continue;
+
+        GLState::BindTexture(0, GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+}
+
+RenderTarget::~RenderTarget()
+{
+    glDeleteFramebuffers(1, &m_fbo_);
+    GLState::DeleteTexture(m_color_);
+    if (m_depth_ != 0)
+        GLState::DeleteTexture(m_depth_);
+}
+
+bool RenderTarget::Resize(glm::ivec2 size)
+{
+    size = glm::max(size, glm::ivec2(1));
+    if (size == size_)
+        return true;
+
+    size_ = size;
+
+    // The data pointer is null, so the pixel format and type only have to be valid for the internal format.
+    GLState::BindTexture(0, GL_TEXTURE_2D, m_color_);
+    glTexImage2D(GL_TEXTURE_2D, 0, color_format_, size_.x, size_.y, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+    if (m_depth_ != 0)
+    {
+        GLState::BindTexture(0, GL_TEXTURE_2D, m_depth_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, size_.x, size_.y, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_color_, 0);
+    if (m_depth_ != 0)
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depth_, 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "[ERROR]: Render target " << size_.x << "x" << size_.y << " is incomplete (status 0x"
+                  << std::hex << status << std::dec << ").\n";
+        return false;
+    }
+    return true;
+}
+
+void RenderTarget::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo_);
+    glViewport(0, 0, size_.x, size_.y);
+}
+
+void RenderTarget::BlitToScreen(glm::ivec2 screen_size) const
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_fbo_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, size_.x, size_.y, 0, 0, screen_size.x, screen_size.y,
+                      GL_COLOR_BUFFER_BIT, size_ == screen_size ? GL_NEAREST : GL_LINEAR);
+    BindScreen(screen_size);
+}
+
+void RenderTarget::BindScreen(glm::ivec2 screen_size)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, screen_size.x, screen_size.y);
+}
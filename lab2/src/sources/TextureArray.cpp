@@ -0,0 +1,400 @@
+#include "TextureArray.hpp"
+
+// Local
+#include "GLState.hpp"
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+// External
+#include <stb_image.h>
+
+using namespace RA;
+
+namespace
+{
+    /// Bump when the cached layout or the resampling changes, so old cache files are ignored.
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    /// Start of every cache file; the decoded pixels follow.
+    struct CacheHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t LayerSize;
+        uint32_t Levels;
+        uint32_t Frames;
+        uint32_t Padding;
+        uint64_t Bytes;
+    };
+
+    /// Width and height of a mip level.
+    int MipSize(int size, int level)
+    {
+        return std::max(size >> level, 1);
+    }
+
+    /// 64-bit FNV-1a, folded over every part of a cache key.
+    uint64_t Hash(uint64_t hash, const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        return hash;
+    }
+
+    /// Bilinear RGBA8 fetch at a continuous position, texel centers at +0.5, clamped to the region.
+    void Sample(const unsigned char *image, int width, int x0, int y0, int w, int h, float x, float y, float *out)
+    {
+        x = std::min(std::max(x - 0.5f, 0.0f), (float)(w - 1));
+        y = std::min(std::max(y - 0.5f, 0.0f), (float)(h - 1));
+        int ix = (int)x, iy = (int)y;
+        int nx = std::min(ix + 1, w - 1), ny = std::min(iy + 1, h - 1);
+        float fx = x - ix, fy = y - iy;
+
+        const unsigned char *p00 = image + 4 * ((y0 + iy) * width + x0 + ix);
+        const unsigned char *p10 = image + 4 * ((y0 + iy) * width + x0 + nx);
+        const unsigned char *p01 = image + 4 * ((y0 + ny) * width + x0 + ix);
+        const unsigned char *p11 = image + 4 * ((y0 + ny) * width + x0 + nx);
+        for (int c = 0; c < 4; c++)
+            out[c] += (p00[c] * (1 - fx) + p10[c] * fx) * (1 - fy) + (p01[c] * (1 - fx) + p11[c] * fx) * fy;
+    }
+
+    /// Resamples the region (x0, y0, w, h) of an RGBA8 image to size x size pixels. Every output pixel
+    /// averages enough bilinear samples to cover its footprint, so large images shrink without aliasing.
+    void Resample(const unsigned char *image, int width, int x0, int y0, int w, int h, int size, unsigned char *out)
+    {
+        float scale_x = (float)w / size, scale_y = (float)h / size;
+        int samples_x = std::max(1, (int)std::ceil(scale_x)), samples_y = std::max(1, (int)std::ceil(scale_y));
+
+        for (int y = 0; y < size; y++)
+            for (int x = 0; x < size; x++)
+            {
+                float sum[4] = {0, 0, 0, 0};
+                for (int sy = 0; sy < samples_y; sy++)
+                    for (int sx = 0; sx < samples_x; sx++)
+                        Sample(image, width, x0, y0, w, h,
+                               (x + (sx + 0.5f) / samples_x) * scale_x, (y + (sy + 0.5f) / samples_y) * scale_y, sum);
+
+                for (int c = 0; c < 4; c++)
+                    out[4 * (y * size + x) + c] = (unsigned char)std::lround(sum[c] / (samples_x * samples_y));
+            }
+    }
+
+    /// Box filters a size x size RGBA8 level into the next, smaller one.
+    void Downsample(const unsigned char *in, int size, unsigned char *out)
+    {
+        int half = std::max(size / 2, 1);
+        for (int y = 0; y < half; y++)
+            for (int x = 0; x < half; x++)
+            {
+                int x0 = std::min(2 * x, size - 1), x1 = std::min(2 * x + 1, size - 1);
+                int y0 = std::min(2 * y, size - 1), y1 = std::min(2 * y + 1, size - 1);
+                for (int c = 0; c < 4; c++)
+                {
+                    int sum = in[4 * (y0 * size + x0) + c] + in[4 * (y0 * size + x1) + c] +
+                              in[4 * (y1 * size + x0) + c] + in[4 * (y1 * size + x1) + c];
+                    out[4 * (y * half + x) + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+    }
+
+    /// Reads a cache file written for the same layout; false on any mismatch.
+    bool ReadCache(const std::string &path, const CacheHeader &expected, std::vector<unsigned char> &pixels)
+    {
+        std::ifstream file(path, std::ios::binary);
+        CacheHeader header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(&header, &expected, sizeof(header)) != 0)
+            return false;
+
+        pixels.resize(header.Bytes);
+        return (bool)file.read(reinterpret_cast<char *>(pixels.data()), header.Bytes);
+    }
+
+    /// Writes a cache file next to its final name and renames it, so a cut off write is never read.
+    void WriteCache(const std::string &path, const CacheHeader &header, const std::vector<unsigned char> &pixels)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(pixels.data()), pixels.size());
+            if (!file)
+            {
+                std::cerr << "[WARNING]: Could not write the texture cache " << path << ".\n";
+                return;
+            }
+        }
+        std::filesystem::rename(temporary, path, error);
+    }
+}
+
+TextureArray::TextureArray(int layer_size, JobSystem *jobs, const std::string &cache_directory)
+    : layer_size_(std::max(layer_size, 1)), jobs_(jobs), cache_directory_(cache_directory)
+{
+    n_levels_ = 1 + (int)std::floor(std::log2((float)layer_size_));
+}
+
+TextureArray::~TextureArray()
+{
+    // The decoding jobs write into the images.
+    if (jobs_)
+        for (const std::unique_ptr<Image> &image : images_)
+            jobs_->Wait(image->Decoded);
+
+    if (m_texture_ != 0)
+    {
+        GLState::DeleteTexture(m_texture_);
+        for (GLuint pbo : m_pbos_)
+            GLState::DeleteBuffer(pbo);
+    }
+}
+
+size_t TextureArray::LayerBytes_() const
+{
+    size_t bytes = 0;
+    for (int level = 0; level < n_levels_; level++)
+        bytes += 4 * (size_t)MipSize(layer_size_, level) * MipSize(layer_size_, level);
+    return bytes;
+}
+
+Sprite TextureArray::Add(const std::string &path, int columns, int rows)
+{
+    if (m_texture_ != 0)
+    {
+        std::cerr << "[ERROR]: Texture array is already built, " << path << " was not added.\n";
+        return Sprite();
+    }
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error))
+    {
+        std::cerr << "Failed to load particle texture: " << path << "\n";
+        return Sprite();
+    }
+
+    if (images_.empty())
+        start_ = std::chrono::steady_clock::now();
+
+    std::unique_ptr<Image> image = std::make_unique<Image>();
+    image->Path = path;
+    image->Columns = std::max(columns, 1);
+    image->Rows = std::max(rows, 1);
+    image->FirstLayer = n_layers_;
+    image->FrameCount = image->Columns * image->Rows;
+
+    Image *decoded = image.get();
+    if (jobs_)
+        decoded->Decoded = jobs_->Submit([this, decoded]()
+                                         { Decode_(*decoded); });
+    else
+        Decode_(*decoded);
+
+    n_layers_ += image->FrameCount;
+    images_.push_back(std::move(image));
+
+    Sprite sprite;
+    sprite.FirstLayer = decoded->FirstLayer;
+    sprite.FrameCount = decoded->FrameCount;
+    return sprite;
+}
+
+void TextureArray::Decode_(Image &image) const
+{
+    size_t layer_bytes = LayerBytes_();
+
+    CacheHeader header = {};
+    std::memcpy(header.Magic, "RATA", 4);
+    header.Version = CACHE_VERSION;
+    header.LayerSize = layer_size_;
+    header.Levels = n_levels_;
+    header.Frames = image.FrameCount;
+    header.Bytes = layer_bytes * image.FrameCount;
+
+    // The cache file is named by the source file, its size and modification time, and the layout.
+    std::string cache_path;
+    if (!cache_directory_.empty())
+    {
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(image.Path, error);
+        int64_t modified = std::filesystem::last_write_time(image.Path, error).time_since_epoch().count();
+        int layout[3] = {layer_size_, image.Columns, image.Rows};
+
+        uint64_t key = 14695981039346656037ull;
+        key = Hash(key, image.Path.data(), image.Path.size());
+        key = Hash(key, &size, sizeof(size));
+        key = Hash(key, &modified, sizeof(modified));
+        key = Hash(key, layout, sizeof(layout));
+        key = Hash(key, &CACHE_VERSION, sizeof(CACHE_VERSION));
+
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+        cache_path = cache_directory_ + "/" + name + ".rgba";
+
+        if (ReadCache(cache_path, header, image.Pixels))
+        {
+            image.Cached = true;
+            return;
+        }
+    }
+
+    int width, height, channels;
+
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    unsigned char *data = stbi_load(image.Path.c_str(), &width, &height, &channels, 4);
+
+    int frame_width = data ? width / image.Columns : 0, frame_height = data ? height / image.Rows : 0;
+    if (frame_width == 0 || frame_height == 0)
+    {
+        std::cerr << "Failed to load particle texture: " << image.Path << "\n";
+        if (data)
+            stbi_image_free(data);
+
+        image.Failed = true;
+        image.Pixels.assign(header.Bytes, 255);
+        return;
+    }
+
+    image.Pixels.resize(header.Bytes);
+
+    // The image is flipped on load, so the top row of frames is at the end of the data.
+    for (int frame = 0; frame < image.FrameCount; frame++)
+    {
+        int x0 = (frame % image.Columns) * frame_width;
+        int y0 = height - (frame / image.Columns + 1) * frame_height;
+        unsigned char *level = image.Pixels.data() + layer_bytes * frame;
+        Resample(data, width, x0, y0, frame_width, frame_height, layer_size_, level);
+
+        // The mip levels follow the layer, each box filtered from the one before.
+        for (int i = 1; i < n_levels_; i++)
+        {
+            int size = MipSize(layer_size_, i - 1);
+            Downsample(level, size, level + 4 * size * size);
+            level += 4 * size * size;
+        }
+    }
+
+    // Free the allocated data on the CPU.
+    stbi_image_free(data);
+
+    if (!cache_path.empty())
+        WriteCache(cache_path, header, image.Pixels);
+}
+
+bool TextureArray::Build()
+{
+    if (m_texture_ != 0)
+        return true;
+
+    if (n_layers_ == 0)
+    {
+        std::cerr << "[WARNING]: Texture array has no layers, particles are drawn without images.\n";
+        return false;
+    }
+
+    glGenTextures(1, &m_texture_);
+    GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_texture_);
+
+    // Immutable storage for all layers and mip levels, transparent until the layers arrive.
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, n_levels_, GL_RGBA8, layer_size_, layer_size_, n_layers_);
+    for (int level = 0; level < n_levels_; level++)
+        glClearTexImage(m_texture_, level, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // Clamping and mipmap settings for the texture.
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glGenBuffers(PBO_COUNT, m_pbos_);
+
+    return true;
+}
+
+void TextureArray::UploadLayer_(Image &image, int layer)
+{
+    size_t layer_bytes = LayerBytes_();
+
+    // Orphan the buffer, so mapping never waits for the copy of its previous layer.
+    GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbos_[next_pbo_]);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, layer_bytes, nullptr, GL_STREAM_DRAW);
+    void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, layer_bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped)
+    {
+        std::memcpy(mapped, image.Pixels.data() + layer_bytes * layer, layer_bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        // The copies read from the bound buffer, at offsets instead of pointers, and return immediately.
+        GLState::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_texture_);
+        size_t offset = 0;
+        for (int level = 0; level < n_levels_; level++)
+        {
+            int size = MipSize(layer_size_, level);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, image.FirstLayer + layer, size, size, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, (void *)offset);
+            offset += 4 * (size_t)size * size;
+        }
+    }
+    else
+        std::cerr << "[ERROR]: Could not map a texture upload buffer, layer " << image.FirstLayer + layer << " stays empty.\n";
+
+    // Other uploads pass client memory pointers.
+    GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    next_pbo_ = (next_pbo_ + 1) % PBO_COUNT;
+}
+
+bool TextureArray::Update(size_t budget_bytes)
+{
+    if (m_texture_ == 0 || IsComplete())
+        return IsComplete();
+
+    size_t layer_bytes = LayerBytes_();
+    size_t spent = 0;
+
+    while (n_uploaded_images_ < images_.size())
+    {
+        Image &image = *images_[n_uploaded_images_];
+        if (!image.Decoded.IsDone())
+            return false;
+
+        for (; image.UploadedLayers < image.FrameCount; image.UploadedLayers++)
+        {
+            if (spent > 0 && spent + layer_bytes > budget_bytes)
+                return false;
+
+            UploadLayer_(image, image.UploadedLayers);
+            spent += layer_bytes;
+        }
+
+        std::vector<unsigned char>().swap(image.Pixels);
+        n_uploaded_images_++;
+    }
+
+    int cached = 0;
+    for (const std::unique_ptr<Image> &image : images_)
+        cached += image->Cached ? 1 : 0;
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    std::cout << "[INFO]: Texture array: " << images_.size() << " images (" << cached << " from the cache), "
+              << n_layers_ << " layers uploaded " << ms << " ms after loading started." << std::endl;
+    return true;
+}
+
+void TextureArray::Finish()
+{
+    if (jobs_)
+        for (const std::unique_ptr<Image> &image : images_)
+            jobs_->Wait(image->Decoded);
+
+    Update(std::numeric_limits<size_t>::max());
+}
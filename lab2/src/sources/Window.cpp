@@ -1,4 +1,6 @@
 #include "Window.hpp"
+#include "GLState.hpp"
+#include "ProgramCache.hpp"
 
 RA::Window::Window(int width, int height, const std::string &title)
 {
@@ -29,6 +31,8 @@ RA::Window::Window(int width, int height, const std::string &title)
         exit(1);
     }
 
+    ProgramCache::Initialize((GLADloadproc)glfwGetProcAddress);
+
     _InitOpenGL();
 }
 
@@ -60,23 +64,33 @@ void RA::Window::FramebufferSizeCallback(GLFWwindow *window, int width, int heig
 
 void RA::Window::_InitOpenGL()
 {
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    GLState::SetCapability(GL_DEPTH_TEST, true);
+    GLState::DepthFunc(GL_LESS);
 
-    glEnable(GL_CULL_FACE);
+    GLState::SetCapability(GL_CULL_FACE, true);
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::SetCapability(GL_BLEND, true);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 void RA::Window::Clear(float r, float g, float b, float a)
 {
     glClearColor(r, g, b, a);
+
+    // Depth writes must be enabled for the depth buffer to be cleared.
+    GLState::DepthMask(true);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+glm::ivec2 RA::Window::GetFramebufferSize() const
+{
+    int width, height;
+    glfwGetFramebufferSize(_Window, &width, &height);
+    return glm::ivec2(width, height);
+}
+
 glm::mat4 RA::Window::GetPerspectiveMatrix(float fov, float nearPlane, float farPlane) const
 {
     int width, height;